@@ -0,0 +1,104 @@
+#include "le_jobs/le_jobs.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+// Stress checks for the job system: each check issues more jobs than the job
+// system's bounded queues can hold, and must complete. A check which does not
+// complete within its time limit has deadlocked - we then exit with an error.
+
+constexpr static uint32_t WORKER_THREAD_COUNT = 2;
+constexpr static auto     IDLE_TIME           = std::chrono::milliseconds( 200 ); // long enough for all workers to park
+constexpr static auto     TIME_LIMIT          = std::chrono::seconds( 10 );
+
+static std::atomic<uint32_t> jobs_executed{ 0 };
+
+static void count_job( void * ) {
+	jobs_executed++;
+}
+
+// ----------------------------------------------------------------------
+// Issue `num_jobs` jobs with given affinity, and wait for them to complete.
+static void run_and_wait( uint32_t num_jobs, int32_t affinity ) {
+	std::vector<le_jobs::job_t> jobs( num_jobs );
+	for ( auto &j : jobs ) {
+		j.fun_ptr = count_job;
+	}
+	le_jobs::counter_t *counter = nullptr;
+	le_jobs::run_jobs_ex( jobs.data(), num_jobs, &counter, LeJobPriority::eNormal, affinity );
+	le_jobs::wait_for_counter_and_free( counter, 0 );
+}
+
+struct nested_params_t {
+	uint32_t num_jobs;
+	int32_t  affinity;
+};
+
+// Issues jobs from within a worker thread.
+static void nested_job( void *user_data ) {
+	auto params = static_cast<nested_params_t const *>( user_data );
+	run_and_wait( params->num_jobs, params->affinity );
+}
+
+// ----------------------------------------------------------------------
+
+static bool check( char const *name, uint32_t num_jobs, int32_t affinity, bool from_worker ) {
+
+	std::this_thread::sleep_for( IDLE_TIME );
+
+	jobs_executed = 0;
+
+	std::atomic<bool> done{ false };
+
+	std::thread watchdog( [ & ]() {
+		auto deadline = std::chrono::steady_clock::now() + TIME_LIMIT;
+		while ( !done ) {
+			if ( std::chrono::steady_clock::now() > deadline ) {
+				fprintf( stderr, "FAIL: %-40s did not complete - %u of %u jobs executed.\n", name, jobs_executed.load(), num_jobs );
+				fflush( stderr );
+				std::_Exit( EXIT_FAILURE );
+			}
+			std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+		}
+	} );
+
+	if ( from_worker ) {
+		nested_params_t     params{ num_jobs, affinity };
+		le_jobs::job_t      job{ nested_job, &params };
+		le_jobs::counter_t *counter = nullptr;
+		le_jobs::run_jobs( &job, 1, &counter );
+		le_jobs::wait_for_counter_and_free( counter, 0 );
+	} else {
+		run_and_wait( num_jobs, affinity );
+	}
+
+	done = true;
+	watchdog.join();
+
+	bool success = ( jobs_executed == num_jobs );
+	printf( "%s: %-40s %u of %u jobs executed.\n", success ? "OK  " : "FAIL", name, jobs_executed.load(), num_jobs );
+	return success;
+}
+
+// ----------------------------------------------------------------------
+
+int main() {
+
+	le_jobs::initialize( WORKER_THREAD_COUNT, 0 );
+
+	bool success = true;
+
+	success &= check( "main thread, any worker", 100000, LE_JOB_AFFINITY_ANY, false );
+	success &= check( "worker thread, any worker", 100000, LE_JOB_AFFINITY_ANY, true );
+	success &= check( "main thread, pinned to worker 0", 5000, 0, false );
+	success &= check( "main thread, pinned to main thread", 5000, LE_JOB_AFFINITY_CALLING_THREAD, false );
+	success &= check( "worker thread, pinned to itself", 5000, LE_JOB_AFFINITY_CALLING_THREAD, true );
+
+	le_jobs::terminate();
+
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
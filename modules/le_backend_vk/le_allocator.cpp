@@ -6,57 +6,168 @@
 
 #include "vulkan/vulkan.hpp"
 
+#include <algorithm>
+#include <vector>
+
 /*
 
 Linear sub-allocator
 
 	+ Hands out memory addresses which can be written to.
 
-	+ Memory must have been allocated and mapped before
+	+ Memory is allocated in blocks from a VMA pool (typically: the frame's pool),
+	all blocks are persistently mapped.
+
+	+ Once a block is exhausted, the allocator chains an additional block from the
+	pool, so that allocations only fail if the pool itself cannot grow.
 
-	+ Memory must be associated to a buffer, but this association is done through
-	the resource-system, we only need to know the LE-api specific handle for the
-	buffer
+	+ Each block is associated with a buffer, but this association is done through
+	the resource-system: the resource handle for a block carries the allocator's index
+	in its lower 8 bits, and the block's index within the allocator in its upper 8 bits.
+	Use `get_le_resource_id` *after* `allocate` to find out which block (and therefore
+	which buffer) the most recent allocation landed in.
+
+	+ On reset, the allocator keeps as many blocks as were needed during the most
+	demanding frame of the recent past (high-water mark), and returns any other
+	blocks to the pool. This way, the next frame starts out with enough capacity,
+	and a one-off spike in usage does not hold on to memory forever.
 
 */
 
+constexpr uint32_t LE_ALLOCATOR_MAX_BLOCKS             = 256; // block index must fit into upper 8 bits of resource handle index
+constexpr uint32_t LE_ALLOCATOR_HIGH_WATER_MARK_WINDOW = 120; // number of resets over which high-water mark is tracked
+
+struct le_allocator_block_t {
+	VkBuffer      buffer      = nullptr;
+	VmaAllocation allocation  = nullptr;
+	uint8_t *     pMappedData = nullptr; // mapped memory address for first byte of block
+};
+
 struct le_allocator_o {
 
-	le_resource_handle_t resourceId = {}; // for transient allocators, this must contain index of transient allocator
+	VmaAllocator vmaAllocator = nullptr; // non-owning
+	VmaPool      pool         = nullptr; // non-owning: pool from which blocks get allocated
+
+	VkBufferCreateInfo    bufferCreateInfo{};  // template for block buffers, .size is block size
+	std::vector<uint32_t> queueFamilyIndices;  // backing storage for bufferCreateInfo.pQueueFamilyIndices
+	le_resource_handle_t  resourceId = {};     // handle for first block, its index must contain index of transient allocator
+	uint64_t              alignment  = 256;    // 1<<8== 256, minimum allocation chunk size (should proabbly be VkPhysicalDeviceLimits::minTexelBufferOffsetAlignment - see bufferView offset "valid use" in Spec: 11.2 )
+	uint64_t              capacity   = 0;      // capacity per block, in bytes
+
+	std::vector<le_allocator_block_t> blocks; // owning
 
-	uint8_t *bufferBaseMemoryAddress = nullptr; // mapped memory address
-	uint64_t bufferBaseOffsetInBytes = 0;       // offset into buffer for first address belonging to this allocator
-	uint64_t capacity                = 0;
-	uint64_t alignment               = 256; // 1<<8== 256, minimum allocation chunk size (should proabbly be VkPhysicalDeviceLimits::minTexelBufferOffsetAlignment - see bufferView offset "valid use" in Spec: 11.2 )
+	uint32_t currentBlock        = 0; // index of block into which we currently allocate
+	uint64_t bufferOffsetInBytes = 0; // offset for next allocation, relative to start of current block
 
-	uint8_t *pData               = bufferBaseMemoryAddress; // address of last allocation, initially: (bufferBaseMemoryAddress + bufferBaseOffsetInBytes)
-	uint64_t bufferOffsetInBytes = bufferBaseOffsetInBytes;
+	uint64_t highWaterMark       = 0; // bytes used in the most demanding frame during the previous and the current window
+	uint64_t highWaterMarkWindow = 0; // bytes used in the most demanding frame during the current window
+	uint32_t resetCount          = 0; // number of resets in current window
+
+	le_allocator_linear_stats_t stats = {};
 };
 
 // ----------------------------------------------------------------------
 
+static uint64_t allocator_get_bytes_used( le_allocator_o const *self ) {
+	// Note that this includes any unused space at the end of exhausted blocks.
+	return self->currentBlock * self->capacity + self->bufferOffsetInBytes;
+}
+
+// ----------------------------------------------------------------------
+
+static bool allocator_add_block( le_allocator_o *self ) {
+
+	if ( self->blocks.size() == LE_ALLOCATOR_MAX_BLOCKS ) {
+		return false;
+	}
+
+	VmaAllocationCreateInfo createInfo{};
+	createInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+	createInfo.pool  = self->pool; // Since we're allocating from a pool all fields but .flags will be taken from the pool
+
+	le_allocator_block_t block;
+	VmaAllocationInfo    allocationInfo;
+
+	auto result = vmaCreateBuffer( self->vmaAllocator, &self->bufferCreateInfo, &createInfo, &block.buffer, &block.allocation, &allocationInfo );
+
+	if ( result != VK_SUCCESS ) {
+		return false;
+	}
+
+	block.pMappedData = static_cast<uint8_t *>( allocationInfo.pMappedData );
+
+	self->blocks.emplace_back( block );
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+static void allocator_release_blocks( le_allocator_o *self, size_t num_blocks_to_keep ) {
+	while ( self->blocks.size() > num_blocks_to_keep ) {
+		auto &block = self->blocks.back();
+		vmaDestroyBuffer( self->vmaAllocator, block.buffer, block.allocation );
+		self->blocks.pop_back();
+	}
+}
+
+// ----------------------------------------------------------------------
+
 static void allocator_reset( le_allocator_o *self ) {
-	self->bufferOffsetInBytes = self->bufferBaseOffsetInBytes;
-	self->pData               = self->bufferBaseMemoryAddress + self->bufferBaseOffsetInBytes;
+
+	uint64_t bytes_used = allocator_get_bytes_used( self );
+
+	// -- Update high-water mark: we track the maximum over a window of resets, and once
+	// the window is complete, the window maximum becomes our new high-water mark.
+
+	self->highWaterMarkWindow = std::max( self->highWaterMarkWindow, bytes_used );
+	self->highWaterMark       = std::max( self->highWaterMark, bytes_used );
+
+	if ( ++self->resetCount == LE_ALLOCATOR_HIGH_WATER_MARK_WINDOW ) {
+		self->highWaterMark       = self->highWaterMarkWindow;
+		self->highWaterMarkWindow = 0;
+		self->resetCount          = 0;
+	}
+
+	// -- Keep enough blocks to satisfy high-water mark, return any others to the pool.
+
+	size_t num_blocks_to_keep = std::max<size_t>( 1, ( self->highWaterMark + self->capacity - 1 ) / self->capacity );
+
+	allocator_release_blocks( self, num_blocks_to_keep );
+
+	self->stats.bytes_used_last_frame  = bytes_used;
+	self->stats.blocks_used_last_frame = self->currentBlock + 1;
+	self->stats.blocks_added           = 0;
+
+	self->currentBlock        = 0;
+	self->bufferOffsetInBytes = 0;
 }
 
 // ----------------------------------------------------------------------
 
-static le_allocator_o *allocator_create( VmaAllocationInfo const *info, uint16_t alignment ) {
+static le_allocator_o *allocator_create( VmaAllocator_T *vmaAllocator, VmaPool_T *pool, VkBufferCreateInfo const *bufferCreateInfo, le_resource_handle_t const *resourceId, uint16_t alignment ) {
 	auto self = new le_allocator_o{};
 
-	self->bufferBaseMemoryAddress = static_cast<uint8_t *>( info->pMappedData );
+	self->vmaAllocator     = vmaAllocator;
+	self->pool             = pool;
+	self->bufferCreateInfo = *bufferCreateInfo;
+	self->resourceId       = *resourceId;
+	self->alignment        = alignment;
+	self->capacity         = bufferCreateInfo->size;
 
-	self->bufferBaseOffsetInBytes = info->offset;
-	self->capacity                = info->size;
-	self->alignment               = alignment;
+	// -- Keep our own copy of queue family indices, so that we don't depend on the caller's memory
+
+	if ( bufferCreateInfo->pQueueFamilyIndices ) {
+		self->queueFamilyIndices.assign( bufferCreateInfo->pQueueFamilyIndices, bufferCreateInfo->pQueueFamilyIndices + bufferCreateInfo->queueFamilyIndexCount );
+	}
 
-	// -- Fetch resource handle of underlying buffer from VmaAllocation info
-	memcpy( &self->resourceId, &info->pUserData, sizeof( void * ) ); // note we copy pUserData as a value
+	self->bufferCreateInfo.pQueueFamilyIndices = self->queueFamilyIndices.data();
 
-	self->resourceId = *reinterpret_cast<le_resource_handle_t const *>( info->pUserData );
+	// -- Allocate first block up-front
 
-	allocator_reset( self );
+	bool result = allocator_add_block( self );
+	assert( result && "could not allocate first block for linear allocator" ); // todo: deal with failed allocation
+	(void)result;
 
 	return self;
 }
@@ -64,6 +175,7 @@ static le_allocator_o *allocator_create( VmaAllocationInfo const *info, uint16_t
 // ----------------------------------------------------------------------
 
 static void allocator_destroy( le_allocator_o *self ) {
+	allocator_release_blocks( self, 0 );
 	delete self;
 }
 
@@ -75,18 +187,31 @@ static bool allocator_allocate( le_allocator_o *self, uint64_t numBytes, void **
 
 	auto allocationSizeInBytes = self->alignment * ( ( numBytes + ( self->alignment - 1 ) ) / self->alignment );
 
-	auto addressAfterAllocation = self->pData + allocationSizeInBytes;
-
-	if ( ( addressAfterAllocation ) > ( self->bufferBaseMemoryAddress + self->bufferBaseOffsetInBytes + self->capacity ) ) {
+	if ( allocationSizeInBytes > self->capacity ) {
+		// Allocation could never fit into a block.
 		return false;
 	}
 
-	// ----------| invariant: enough capacity to accomodate numBytes
+	if ( self->bufferOffsetInBytes + allocationSizeInBytes > self->capacity ) {
 
-	*pData        = self->pData; // point to next free memory address
-	*bufferOffset = self->bufferOffsetInBytes;
+		// Current block is exhausted - move on to the next block, which we
+		// might have to allocate first.
+
+		if ( self->currentBlock + 1 == self->blocks.size() ) {
+			if ( !allocator_add_block( self ) ) {
+				return false;
+			}
+			self->stats.blocks_added++;
+		}
+
+		self->currentBlock++;
+		self->bufferOffsetInBytes = 0;
+	}
+
+	// ----------| invariant: enough capacity in current block to accomodate numBytes
 
-	self->pData = addressAfterAllocation;
+	*pData        = self->blocks[ self->currentBlock ].pMappedData + self->bufferOffsetInBytes; // point to next free memory address
+	*bufferOffset = self->bufferOffsetInBytes;
 
 	self->bufferOffsetInBytes += allocationSizeInBytes;
 
@@ -94,9 +219,30 @@ static bool allocator_allocate( le_allocator_o *self, uint64_t numBytes, void **
 }
 
 // ----------------------------------------------------------------------
-
+// Returns resource handle for the block into which the most recent allocation went.
 static le_resource_handle_t allocator_get_le_resource_id( le_allocator_o *self ) {
-	return self->resourceId;
+	le_resource_handle_t result = self->resourceId;
+	result.handle.as_handle.meta.as_meta.index |= uint16_t( self->currentBlock << 8 );
+	return result;
+}
+
+// ----------------------------------------------------------------------
+// Returns buffer for block given by upper 8 bits of the index of a resource
+// handle issued by this allocator.
+static VkBuffer_T *allocator_get_block_buffer( le_allocator_o *self, uint16_t resource_index ) {
+	uint32_t block_index = resource_index >> 8;
+	assert( block_index < self->blocks.size() );
+	return self->blocks[ block_index ].buffer;
+}
+
+// ----------------------------------------------------------------------
+
+static void allocator_get_stats( le_allocator_o *self, le_allocator_linear_stats_t *stats ) {
+	*stats                 = self->stats;
+	stats->bytes_used      = allocator_get_bytes_used( self );
+	stats->high_water_mark = self->highWaterMark;
+	stats->capacity        = self->blocks.size() * self->capacity;
+	stats->block_count     = uint32_t( self->blocks.size() );
 }
 
 // ----------------------------------------------------------------------
@@ -109,8 +255,10 @@ void register_le_allocator_linear_api( void *api_ ) {
 	le_allocator_linear_i.create             = allocator_create;
 	le_allocator_linear_i.destroy            = allocator_destroy;
 	le_allocator_linear_i.get_le_resource_id = allocator_get_le_resource_id;
+	le_allocator_linear_i.get_block_buffer   = allocator_get_block_buffer;
 	le_allocator_linear_i.allocate           = allocator_allocate;
 	le_allocator_linear_i.reset              = allocator_reset;
+	le_allocator_linear_i.get_stats          = allocator_get_stats;
 }
 
 // ----------------------------------------------------------------------
@@ -231,6 +231,7 @@ struct LeRenderPass {
 		uint32_t             active;
 	};
 
-	std::string                 debugName;         // Debug name for renderpass
-	std::vector<ExplicitSyncOp> explicit_sync_ops; // explicit sync operations for renderpass, these execute before renderpass begins.
+	std::string                 debugName;            // Debug name for renderpass
+	std::vector<ExplicitSyncOp> explicit_sync_ops;    // explicit sync operations for renderpass, these execute before renderpass begins.
+	bool                        needsAliasingBarrier; // whether pass is first to use images which share memory with earlier images, see le_transient_heap_t
 };
@@ -13,10 +13,12 @@
 #include "3rdparty/src/spooky/SpookyV2.h" // for hashing renderpass gestalt
 
 #include <vector>
+#include <algorithm>
 #include <unordered_map>
 #include <forward_list>
 #include <iostream>
 #include <iomanip>
+#include <chrono>
 #include <list>
 #include <set>
 #include <atomic>
@@ -24,6 +26,14 @@
 
 #include <memory>
 
+#ifndef LE_MT
+#	define LE_MT 0
+#endif
+
+#if ( LE_MT > 0 )
+#	include "le_jobs/le_jobs.h"
+#endif
+
 #ifndef PRINT_DEBUG_MESSAGES
 #	define PRINT_DEBUG_MESSAGES false
 #endif
@@ -33,6 +43,11 @@
 #	define DEBUG_TAG_RESOURCES true
 #endif
 
+#ifndef LE_BACKEND_ALIAS_TRANSIENT_IMAGES
+// Whether transient images with non-overlapping lifetimes may share memory.
+#	define LE_BACKEND_ALIAS_TRANSIENT_IMAGES true
+#endif
+
 // Helper macro to convert le:: enums to vk:: enums
 #define LE_ENUM_TO_VK( enum_name, fun_name )                                    \
 	static inline vk::enum_name fun_name( le::enum_name const &rhs ) noexcept { \
@@ -46,7 +61,11 @@
 
 constexpr size_t LE_FRAME_DATA_POOL_BLOCK_SIZE  = 1u << 24; // 16.77 MB
 constexpr size_t LE_FRAME_DATA_POOL_BLOCK_COUNT = 1;
-constexpr size_t LE_LINEAR_ALLOCATOR_SIZE       = 1u << 24;
+constexpr size_t LE_LINEAR_ALLOCATOR_SIZE       = 1u << 24; // size per linear allocator block, must not exceed LE_FRAME_DATA_POOL_BLOCK_SIZE
+
+constexpr uint32_t LE_DESCRIPTOR_POOL_MIN_SETS        = 64; // minimum capacity of a descriptor pool, in sets
+constexpr uint32_t LE_DESCRIPTOR_POOL_MIN_DESCRIPTORS = 64; // minimum capacity of a descriptor pool, in descriptors per type
+constexpr uint32_t LE_DESCRIPTOR_CACHE_MAX_UNUSED     = 64; // entries a descriptor cache may hold beyond twice the entries used last frame before it gets flushed
 
 struct LeRtxBlasCreateInfo {
 	le_rtx_blas_info_handle handle;
@@ -396,13 +415,189 @@ struct AllocatedResourceVk {
 	uint32_t           padding__;
 };
 
+// Staging memory is sub-allocated from large, persistently mapped blocks. Blocks are
+// kept across frames, and recycled once the frame which used them has been cleared -
+// that is, once its fence has signalled. Allocations too large to share a block get
+// a buffer of their own.
+//
+// Buffer-image copies require buffer offsets which are a multiple of both 4, and the
+// format's texel block size - which may be 1, 2, 3, 4, 6, 8, 12, 16, 24, or 32 Bytes.
+// Sub-allocations are therefore aligned to lcm(256, 3) = 768 Bytes, which is a multiple
+// of all these, and of any power of two up to 256 (e.g. optimalBufferCopyOffsetAlignment).
+static constexpr uint64_t LE_STAGING_BLOCK_SIZE              = 1ull << 24;                // 16 MiB
+static constexpr uint64_t LE_STAGING_DEDICATED_THRESHOLD     = LE_STAGING_BLOCK_SIZE / 4; // allocations larger than this get a dedicated buffer
+static constexpr uint64_t LE_STAGING_ALIGNMENT               = 768;                       // satisfies buffer-image copy offset alignment for all formats, see above
+static constexpr uint32_t LE_STAGING_ALLOCATIONS_PER_CHUNK   = 1024;                      //
+static constexpr uint32_t LE_STAGING_ALLOCATION_CHUNKS_COUNT = 64;                        // 64 * 1024 allocations per frame, as resource handle index is 16 bit
+static_assert( LE_STAGING_ALLOCATIONS_PER_CHUNK * LE_STAGING_ALLOCATION_CHUNKS_COUNT <= 1 << 16, "staging allocation index must fit resource handle index" );
+static_assert( LE_STAGING_ALIGNMENT % 256 == 0 && LE_STAGING_ALIGNMENT % 3 == 0, "staging alignment must be a multiple of all texel block sizes" );
+
+struct le_staging_block_t {
+	VkBuffer              buffer     = nullptr;
+	VmaAllocation         allocation = nullptr;
+	char *                data       = nullptr; // persistently mapped
+	uint64_t              size       = 0;
+	std::atomic<uint64_t> offset{ 0 }; // bump pointer - may grow beyond size once block is exhausted
+};
+
+// Where the memory for a staging allocation lives - staging resource handles refer to one of these via their index.
+struct le_staging_allocation_t {
+	VkBuffer buffer;
+	uint64_t offset;
+};
+
 struct le_staging_allocator_o {
-	VmaAllocator                   allocator;      // non-owning, refers to backend allocator object
-	VkDevice                       device;         // non-owning, refers to vulkan device object
-	std::mutex                     mtx;            // protects all staging* elements
-	std::vector<vk::Buffer>        buffers;        // 0..n staging buffers used with the current frame (freed on frame clear)
-	std::vector<VmaAllocation>     allocations;    // SOA: counterpart to buffers[]
-	std::vector<VmaAllocationInfo> allocationInfo; // SOA: counterpart to buffers[]
+	VmaAllocator allocator; // non-owning, refers to backend allocator object
+	VkDevice     device;    // non-owning, refers to vulkan device object
+
+	// -- Lock-free: allocations for the current frame are bump-allocated from currentBlock.
+
+	std::atomic<le_staging_block_t *>      currentBlock{ nullptr };                            // block which we currently sub-allocate from, nullptr if none
+	std::atomic<uint32_t>                  allocationsCount{ 0 };                              // number of allocations for the current frame
+	std::atomic<le_staging_allocation_t *> allocationChunks[ LE_STAGING_ALLOCATION_CHUNKS_COUNT ]{}; // owning - created on demand, reused across frames
+
+	// -- Slow path: only touched when a block is exhausted, for large allocations, and on reset.
+
+	std::mutex                        mtx;                  // protects all elements below
+	std::vector<le_staging_block_t *> blocks;               // owning - blocks used with the current frame
+	std::vector<le_staging_block_t *> freeBlocks;           // owning - blocks available for re-use
+	std::vector<VkBuffer>             dedicatedBuffers;     // 0..n dedicated staging buffers used with the current frame (freed on frame clear)
+	std::vector<VmaAllocation>        dedicatedAllocations; // SOA: counterpart to dedicatedBuffers[]
+
+	// -- Statistics, printed when the allocator is destroyed.
+
+	std::atomic<uint64_t> statsBytesStaged{ 0 };       // total number of bytes handed out
+	std::atomic<uint64_t> statsAllocationsCount{ 0 };  // total number of allocations
+	std::atomic<uint64_t> statsDriverAllocations{ 0 }; // total number of buffers created via vma - blocks, and dedicated buffers
+	std::atomic<uint64_t> statsMapNanoseconds{ 0 };    // total time spent in staging_allocator_map
+};
+
+// Returns staging allocation at `index`, or nullptr if there is no allocation with this index.
+static inline le_staging_allocation_t const *staging_allocator_get_allocation( le_staging_allocator_o const *self, uint32_t index ) {
+	if ( index >= self->allocationsCount.load( std::memory_order_relaxed ) ) {
+		return nullptr;
+	}
+	auto chunk = self->allocationChunks[ index / LE_STAGING_ALLOCATIONS_PER_CHUNK ].load( std::memory_order_acquire );
+	return chunk + ( index % LE_STAGING_ALLOCATIONS_PER_CHUNK );
+}
+
+// ------------------------------------------------------------
+
+// Cache for vulkan objects which are expensive to create, but which tend to be
+// identical from frame to frame: renderpasses, framebuffers, image views, and samplers.
+//
+// Objects are looked up via a hash over their create info. Each frame holds a
+// reference to every cached object it uses, and releases these references when
+// it is cleared.
+//
+// Image views and framebuffers refer to images. Whenever an image gets destroyed,
+// we evict any objects which refer to it: evicted objects can't be found anymore,
+// and are destroyed as soon as the last frame using them has released them.
+// Renderpasses and samplers don't refer to images, and live until the backend is destroyed.
+struct le_vk_object_cache_o : NoCopy, NoMove {
+	struct Entry {
+		AbstractPhysicalResource resource;
+		std::vector<uint8_t>     key;                // create info bytes which identify this object - compared on lookup, so that hash collisions can't return the wrong object
+		std::vector<VkImage>     images;             // images this object refers to, if any
+		uint32_t                 ref_count  = 0;     // number of frames currently holding this object
+		bool                     is_evicted = false; // entry was removed from cache, destroy once ref_count drops to zero
+	};
+	std::mutex                            mtx;     // protects all entries, and all entry ref counts
+	std::unordered_map<uint64_t, Entry *> entries; // owning, indexed by hash over type and key
+};
+
+// ------------------------------------------------------------
+
+// Descriptor types for which descriptor pools reserve capacity.
+static constexpr vk::DescriptorType LE_DESCRIPTOR_POOL_TYPES[] = {
+    vk::DescriptorType::eSampler,
+    vk::DescriptorType::eCombinedImageSampler,
+    vk::DescriptorType::eSampledImage,
+    vk::DescriptorType::eStorageImage,
+    vk::DescriptorType::eUniformTexelBuffer,
+    vk::DescriptorType::eStorageTexelBuffer,
+    vk::DescriptorType::eUniformBuffer,
+    vk::DescriptorType::eStorageBuffer,
+    vk::DescriptorType::eUniformBufferDynamic,
+    vk::DescriptorType::eStorageBufferDynamic,
+    vk::DescriptorType::eInputAttachment,
+#ifdef LE_FEATURE_RTX
+    vk::DescriptorType::eAccelerationStructureKHR,
+#endif
+};
+
+constexpr size_t LE_DESCRIPTOR_TYPE_COUNT = sizeof( LE_DESCRIPTOR_POOL_TYPES ) / sizeof( vk::DescriptorType );
+
+// Descriptor set cache - one per pass, per frame.
+//
+// Descriptor sets are cached by a hash over their layout and contents, so that
+// draws which use the same arguments - in the same pass, or in the pass at the same
+// index in any later frame - re-use descriptor sets instead of allocating and
+// writing new ones.
+//
+// Descriptor sets are allocated from pools owned by the cache. If the current pool
+// runs out of space, we add a pool twice its size. When the cache gets flushed, we
+// replace all its pools with a single pool sized to what was used since the last flush.
+//
+// The cache gets flushed if the backend's descriptor cache epoch has changed (which
+// means that objects which cached descriptors may refer to have been destroyed),
+// or if it holds significantly more entries than were used in the previous frame.
+struct le_descriptor_cache_o {
+	struct Entry {
+		vk::DescriptorSet           descriptorSet;
+		vk::DescriptorSetLayout     setLayout;
+		std::vector<DescriptorData> setData;
+		uint64_t                    lastUsedFrame = 0; // cache frame number at which this entry was last used
+	};
+
+	std::vector<vk::DescriptorPool>     pools;   // owning; sets are allocated from pools.back(), any other pools are full.
+	std::unordered_map<uint64_t, Entry> entries; // indexed by hash over set layout and set data
+
+	uint64_t epoch       = 0; // backend descriptor cache epoch at which entries were last validated
+	uint64_t frameNumber = 0; // incremented every time the cache is used for a new frame
+
+	uint32_t entriesUsed          = 0; // entries used during the current frame
+	uint32_t entriesUsedLastFrame = 0; // entries used during the previous frame
+
+	uint32_t                                        poolMaxSets = 0;        // capacity of pools.back()
+	std::array<uint32_t, LE_DESCRIPTOR_TYPE_COUNT> poolDescriptorCounts{}; // capacity of pools.back(), per descriptor type
+
+	uint32_t                                        setsAllocated = 0;        // since last flush
+	std::array<uint32_t, LE_DESCRIPTOR_TYPE_COUNT> descriptorsAllocated{};   // since last flush, per descriptor type
+
+	uint64_t statsSetsAllocated = 0; // during current frame
+	uint64_t statsSetsReused    = 0; // during current frame - allocations avoided thanks to cache
+};
+
+// ------------------------------------------------------------
+
+// Transient images are images which are used within a single frame only: they are
+// declared transient (see ImageInfoBuilder::setIsTransient), and their first use in a
+// frame is as an attachment which does not load its previous contents.
+//
+// Transient images whose lifetimes (the range of passes from first to last use) don't
+// overlap may share memory. We place all transient images into one heap allocation, and
+// keep this layout for as long as it stays valid - that is, for as long as it holds all
+// transient images used by the frame, and images which share memory keep non-overlapping
+// lifetimes. Images which are not used by a frame keep their place in the heap.
+//
+// Images which share memory with other images start each frame in undefined layout, and
+// the first pass using them must wait for all earlier accesses to the heap.
+struct le_transient_heap_t {
+	struct Entry {
+		le_resource_handle_t resource_id;
+		ResourceCreateInfo   info;       // create info with which the image was created
+		uint64_t             offset;     // offset into heap allocation
+		uint64_t             size;       // memory requirements size for image
+		uint32_t             first_pass; // index of first pass using image, as of the most recent frame using image
+		uint32_t             last_pass;  // index of last pass using image, as of the most recent frame using image
+		bool                 in_use;     // whether image is used by the current frame
+	};
+
+	VmaAllocation                     allocation = nullptr; // owning
+	uint64_t                          size       = 0;
+	std::vector<Entry>                entries;
+	std::vector<le_resource_handle_t> unplaced; // transient images which could not be placed into heap, and are allocated individually
 };
 
 // ------------------------------------------------------------
@@ -417,11 +612,12 @@ struct BackendFrameData {
 	vk::Fence                      frameFence               = nullptr;
 	vk::Semaphore                  semaphoreRenderComplete  = nullptr;
 	vk::Semaphore                  semaphorePresentComplete = nullptr;
-	vk::CommandPool                commandPool              = nullptr;
+	std::vector<vk::CommandPool>   commandPools;                 // one pool per execution context (worker thread), so that passes may be translated in parallel, plus one for threads outside the job system
 	uint32_t                       swapchainImageIndex      = uint32_t( ~0 );
 	uint32_t                       swapchainWidth           = 0; // Swapchain may be resized, therefore it needs to be stored with frame
 	uint32_t                       swapchainHeight          = 0; // Swapchain may be resized, therefore it needs to be stored with frame
-	std::vector<vk::CommandBuffer> commandBuffers;
+	std::vector<vk::CommandBuffer> commandBuffers;           // one primary command buffer per pass, in pass order
+	std::vector<uint32_t>          commandBufferPoolIndices; // SOA: counterpart to commandBuffers - index into commandPools of the pool owning each command buffer
 
 	struct Texture {
 		vk::Sampler   sampler;
@@ -448,6 +644,9 @@ struct BackendFrameData {
 	/// \brief vk resources retained and destroyed with BackendFrameData
 	std::forward_list<AbstractPhysicalResource> ownedResources;
 
+	/// \brief cached vk objects used by this frame, references are released on frame clear
+	std::vector<le_vk_object_cache_o::Entry *> cachedObjects;
+
 	/// \brief if user provides explicit resource info, we collect this here, so that we can make sure
 	/// that any inferred resourceInfo is compatible with what the user selected.
 	std::vector<le_resource_handle_t> declared_resources_id;   // | pre-declared resources (declared via module)
@@ -456,7 +655,7 @@ struct BackendFrameData {
 	std::vector<LeRenderPass>  passes;
 	std::vector<texture_map_t> textures_per_pass; // non-owning, references to frame-local textures, cleared on frame fence.
 
-	std::vector<vk::DescriptorPool> descriptorPools; // one descriptor pool per pass
+	std::vector<le_descriptor_cache_o> descriptorCaches; // one descriptor cache per pass
 
 	/*
 
@@ -473,12 +672,18 @@ struct BackendFrameData {
 	ResourceMap_T availableResources; // resources this frame may use
 	ResourceMap_T binnedResources;    // resources to delete when this frame comes round to clear()
 
+	std::vector<VmaAllocation> binnedAllocations; // memory to free when this frame comes round to clear() - freed after binnedResources
+
+	struct AliasedResource {
+		le_resource_handle_t resource_id;
+		uint32_t             first_pass; // index of first pass using this resource in this frame
+	};
+
+	std::vector<AliasedResource> aliasedResources; // transient images which share memory with other transient images
+
 	VmaPool allocationPool; // pool from which allocations for this frame come from
 
-	std::vector<le_allocator_o *>  allocators;       // owning; typically one per `le_worker_thread`.
-	std::vector<vk::Buffer>        allocatorBuffers; // per allocator: one vkBuffer
-	std::vector<VmaAllocation>     allocations;      // per allocator: one allocation
-	std::vector<VmaAllocationInfo> allocationInfos;  // per allocator: one allocationInfo
+	std::vector<le_allocator_o *> allocators; // owning; typically one per `le_worker_thread`. Each allocator owns its buffers, allocated from `allocationPool`.
 
 	le_staging_allocator_o *stagingAllocator; // owning: allocator for large objects to GPU memory
 };
@@ -518,6 +723,18 @@ struct le_backend_o {
 
 	le_pipeline_manager_o *pipelineCache = nullptr;
 
+	// Descriptor sets refer to objects by handle - since handles of destroyed objects may be re-used
+	// by the driver, cached descriptor sets must be discarded whenever objects which they might refer
+	// to get destroyed. We signal this by incrementing the epoch.
+	std::atomic<uint64_t> descriptorCacheEpoch{ 0 };
+	std::atomic<uint64_t> descriptorSetsAllocated{ 0 };
+	std::atomic<uint64_t> descriptorSetsReused{ 0 }; // descriptor set allocations avoided thanks to descriptor caches
+
+	std::atomic<uint64_t> commandsRecorded{ 0 }; // commands decoded from encoders, over all passes
+	std::atomic<uint64_t> commandsElided{ 0 };   // commands which encoders dropped because they would not have changed state
+
+	le_vk_object_cache_o objectCache; // renderpasses, framebuffers, image views, and samplers shared by all frames
+
 	VmaAllocator mAllocator = nullptr;
 
 	uint32_t swapchainWidth  = 0; ///< swapchain width gathered when setting/resetting swapchain
@@ -531,6 +748,7 @@ struct le_backend_o {
 
 	struct {
 		std::unordered_map<le_resource_handle_t, AllocatedResourceVk, LeResourceHandleIdentity> allocatedResources; // Allocated resources, indexed by resource name hash
+		le_transient_heap_t                                                                     transientHeap;      // Memory shared by transient images - images are owned by allocatedResources
 	} only_backend_allocate_resources_may_access;                                                                   // Only acquire_physical_resources may read/write
 };
 
@@ -624,6 +842,158 @@ static le_backend_o *backend_create() {
 
 // ----------------------------------------------------------------------
 
+static void abstract_physical_resource_destroy( vk::Device const &device, AbstractPhysicalResource const &r ) {
+	switch ( r.type ) {
+	case AbstractPhysicalResource::eBuffer:
+		device.destroyBuffer( r.asBuffer );
+		break;
+	case AbstractPhysicalResource::eFramebuffer:
+		device.destroyFramebuffer( r.asFramebuffer );
+		break;
+	case AbstractPhysicalResource::eImage:
+		device.destroyImage( r.asImage );
+		break;
+	case AbstractPhysicalResource::eImageView:
+		device.destroyImageView( r.asImageView );
+		break;
+	case AbstractPhysicalResource::eRenderPass:
+		device.destroyRenderPass( r.asRenderPass );
+		break;
+	case AbstractPhysicalResource::eSampler:
+		device.destroySampler( r.asSampler );
+		break;
+
+	case AbstractPhysicalResource::eUndefined:
+		std::cout << __PRETTY_FUNCTION__ << ": abstract physical resource has unknown type (" << std::hex << r.type << ") and cannot be deleted. leaking..." << std::flush;
+		break;
+	}
+}
+
+// ----------------------------------------------------------------------
+// Appends raw bytes to an object cache key.
+static void object_cache_key_append( std::vector<uint8_t> &key, void const *data, size_t numBytes ) {
+	auto bytes = static_cast<uint8_t const *>( data );
+	key.insert( key.end(), bytes, bytes + numBytes );
+}
+
+// ----------------------------------------------------------------------
+// Returns cached object of `type` identified by `key` - or, if no such object exists
+// in the cache, creates a new object by calling `create` and stores it with the cache.
+//
+// `key` must hold all create info which goes into the object. We look up objects by
+// a hash over `key`, and compare key bytes on a hit - if another object is stored
+// under the same hash, we create a new object which is not cached.
+//
+// `images` lists any images which the object refers to - the object
+// gets evicted as soon as any of these images is destroyed.
+//
+// The frame receives a reference to the object, which it will
+// release once it gets cleared.
+template <typename CreateFn>
+static AbstractPhysicalResource object_cache_acquire( le_vk_object_cache_o *self, BackendFrameData &frame, AbstractPhysicalResource::Type type,
+                                                      void const *key, size_t keyNumBytes,
+                                                      VkImage const *images, size_t numImages, CreateFn &&create ) {
+
+	uint64_t hash = SpookyHash::Hash64( key, keyNumBytes, type );
+
+	auto lock = std::scoped_lock( self->mtx );
+
+	auto &cached = self->entries[ hash ];
+
+	bool is_match = cached &&
+	                cached->resource.type == type &&
+	                cached->key.size() == keyNumBytes &&
+	                0 == memcmp( cached->key.data(), key, keyNumBytes );
+
+	le_vk_object_cache_o::Entry *entry = is_match ? cached : nullptr;
+
+	if ( entry == nullptr ) {
+		auto key_bytes = static_cast<uint8_t const *>( key );
+
+		entry           = new le_vk_object_cache_o::Entry();
+		entry->resource = create();
+		entry->key.assign( key_bytes, key_bytes + keyNumBytes );
+		entry->images.assign( images, images + numImages );
+
+		if ( cached == nullptr ) {
+			cached = entry;
+		} else {
+			// Hash collision: another object is stored under this hash. We don't cache
+			// the new object - it gets destroyed once the frame has released it.
+			entry->is_evicted = true;
+		}
+	}
+
+	entry->ref_count++;
+	frame.cachedObjects.push_back( entry );
+
+	return entry->resource;
+}
+
+// ----------------------------------------------------------------------
+// Releases all references which a frame holds to cached objects.
+static void object_cache_release_frame_objects( le_vk_object_cache_o *self, vk::Device const &device, BackendFrameData &frame ) {
+	auto lock = std::scoped_lock( self->mtx );
+
+	for ( auto &entry : frame.cachedObjects ) {
+		if ( --entry->ref_count == 0 && entry->is_evicted ) {
+			abstract_physical_resource_destroy( device, entry->resource );
+			delete entry;
+		}
+	}
+
+	frame.cachedObjects.clear();
+}
+
+// ----------------------------------------------------------------------
+// Evicts all cached objects which refer to any of the given images.
+// Must be called before images are destroyed, as image handles may be re-used by the driver.
+static void object_cache_evict_images( le_vk_object_cache_o *self, vk::Device const &device, VkImage const *images, size_t numImages ) {
+	auto lock = std::scoped_lock( self->mtx );
+
+	for ( auto it = self->entries.begin(); it != self->entries.end(); ) {
+
+		auto &entry = it->second;
+
+		bool refers_to_image = std::any_of( images, images + numImages, [ & ]( VkImage const &img ) {
+			return std::find( entry->images.begin(), entry->images.end(), img ) != entry->images.end();
+		} );
+
+		if ( !refers_to_image ) {
+			it++;
+			continue;
+		}
+
+		if ( entry->ref_count == 0 ) {
+			abstract_physical_resource_destroy( device, entry->resource );
+			delete entry;
+		} else {
+			// Frames still hold references to this object - it will be
+			// destroyed once the last frame has released it.
+			entry->is_evicted = true;
+		}
+
+		it = self->entries.erase( it );
+	}
+}
+
+// ----------------------------------------------------------------------
+// Destroys all objects held by the cache.
+// All frames must have released their references before calling this method.
+static void object_cache_clear( le_vk_object_cache_o *self, vk::Device const &device ) {
+	auto lock = std::scoped_lock( self->mtx );
+
+	for ( auto &e : self->entries ) {
+		assert( e.second->ref_count == 0 );
+		abstract_physical_resource_destroy( device, e.second->resource );
+		delete e.second;
+	}
+
+	self->entries.clear();
+}
+
+// ----------------------------------------------------------------------
+
 static void backend_destroy( le_backend_o *self ) {
 
 	if ( self->pipelineCache ) {
@@ -645,39 +1015,46 @@ static void backend_destroy( le_backend_o *self ) {
 		self->swapchain = nullptr;
 	}
 
+	if ( self->descriptorSetsAllocated || self->descriptorSetsReused ) {
+		std::cout << "Descriptor cache: " << std::dec << self->descriptorSetsAllocated << " descriptor sets allocated, "
+		          << self->descriptorSetsReused << " allocations avoided" << std::endl
+		          << std::flush;
+	}
+
+	if ( self->commandsElided ) {
+		std::cout << "Command encoders: " << std::dec << self->commandsRecorded << " commands recorded, "
+		          << self->commandsElided << " redundant commands elided" << std::endl
+		          << std::flush;
+	}
+
 	for ( auto &frameData : self->mFrames ) {
 
 		using namespace le_backend_vk;
 
 		// -- destroy per-frame data
 
+		object_cache_release_frame_objects( &self->objectCache, device, frameData );
+
 		device.destroyFence( frameData.frameFence );
 		device.destroySemaphore( frameData.semaphorePresentComplete );
 		device.destroySemaphore( frameData.semaphoreRenderComplete );
-		device.destroyCommandPool( frameData.commandPool );
+		for ( auto &pool : frameData.commandPools ) {
+			device.destroyCommandPool( pool );
+		}
 
-		for ( auto &d : frameData.descriptorPools ) {
-			device.destroyDescriptorPool( d );
+		for ( auto &c : frameData.descriptorCaches ) {
+			for ( auto &p : c.pools ) {
+				device.destroyDescriptorPool( p );
+			}
 		}
 
 		{
-			// Destroy linear allocators, and the buffers allocated for them.
-			assert( frameData.allocatorBuffers.size() == frameData.allocators.size() &&
-			        frameData.allocatorBuffers.size() == frameData.allocations.size() &&
-			        frameData.allocatorBuffers.size() == frameData.allocationInfos.size() );
-
-			vk::Buffer *   buffer     = frameData.allocatorBuffers.data();
-			VmaAllocation *allocation = frameData.allocations.data();
-
-			for ( auto allocator = frameData.allocators.begin(); allocator != frameData.allocators.end(); allocator++, buffer++, allocation++ ) {
-				le_allocator_linear_i.destroy( *allocator );
-				vmaDestroyBuffer( self->mAllocator, *buffer, *allocation );
+			// Destroy linear allocators - this frees the buffers allocated for them.
+			for ( auto &allocator : frameData.allocators ) {
+				le_allocator_linear_i.destroy( allocator );
 			}
 
 			frameData.allocators.clear();
-			frameData.allocatorBuffers.clear();
-			frameData.allocations.clear();
-			frameData.allocationInfos.clear();
 		}
 
 		vmaDestroyPool( self->mAllocator, frameData.allocationPool );
@@ -697,10 +1074,18 @@ static void backend_destroy( le_backend_o *self ) {
 			vmaFreeMemory( self->mAllocator, a.second.allocation );
 		}
 		frameData.binnedResources.clear();
+
+		for ( auto &a : frameData.binnedAllocations ) {
+			vmaFreeMemory( self->mAllocator, a );
+		}
+		frameData.binnedAllocations.clear();
 	}
 
 	self->mFrames.clear();
 
+	// All frames have released their cached objects, we may now destroy them.
+	object_cache_clear( &self->objectCache, device );
+
 	// Remove any resources still alive in the backend.
 	// At this point we're running single-threaded, so we can ignore the
 	// ownership claim on allocatedResources.
@@ -730,6 +1115,10 @@ static void backend_destroy( le_backend_o *self ) {
 
 	self->only_backend_allocate_resources_may_access.allocatedResources.clear();
 
+	// Transient heap memory may only be freed once all images placed into it have been destroyed.
+	vmaFreeMemory( self->mAllocator, self->only_backend_allocate_resources_may_access.transientHeap.allocation );
+	self->only_backend_allocate_resources_may_access.transientHeap = {};
+
 	if ( self->mAllocator ) {
 		vmaDestroyAllocator( self->mAllocator );
 		self->mAllocator = nullptr;
@@ -826,6 +1215,16 @@ static void backend_get_swapchain_extent( le_backend_o *self, uint32_t *p_width,
 static void backend_reset_swapchain( le_backend_o *self ) {
 	using namespace le_swapchain_vk;
 
+	{
+		// Swapchain images are about to be destroyed - evict any cached objects which refer to them.
+		self->descriptorCacheEpoch++;
+		std::vector<VkImage> swapchain_images( swapchain_i.get_images_count( self->swapchain ) );
+		for ( size_t i = 0; i != swapchain_images.size(); i++ ) {
+			swapchain_images[ i ] = swapchain_i.get_image( self->swapchain, uint32_t( i ) );
+		}
+		object_cache_evict_images( &self->objectCache, self->device->getVkDevice(), swapchain_images.data(), swapchain_images.size() );
+	}
+
 	swapchain_i.reset( self->swapchain, nullptr );
 	// We must update our cached values for swapchain dimensions if the swapchain was reset.
 	self->swapchainWidth  = swapchain_i.get_image_width( self->swapchain );
@@ -838,7 +1237,8 @@ static void backend_reset_swapchain( le_backend_o *self ) {
 /// \details This is an internal method. Virtual buffers are buffers which don't have individual
 /// Vulkan buffer backing. Instead, they use their Frame's buffer for storage. Virtual buffers
 /// are used to store Frame-local transient data such as values for shader parameters.
-/// Each Encoder uses its own virtual buffer for such purposes.
+/// Each Encoder uses its own virtual buffer for such purposes - the upper 8 bits of `index`
+/// are reserved for the allocator, which uses them to tell apart its blocks.
 static le_resource_handle_t declare_resource_virtual_buffer( uint8_t index ) {
 
 	auto resource = LE_BUF_RESOURCE( "Encoder-Virtual" ); // virtual resources all have the same id, which means they are not part of the regular roster of resources...
@@ -1067,7 +1467,13 @@ static void backend_setup( le_backend_o *self, le_backend_vk_settings_t *setting
 		frameData.frameFence               = vkDevice.createFence( {} ); // fence starts out as "signalled"
 		frameData.semaphorePresentComplete = vkDevice.createSemaphore( {} );
 		frameData.semaphoreRenderComplete  = vkDevice.createSemaphore( {} );
-		frameData.commandPool              = vkDevice.createCommandPool( { vk::CommandPoolCreateFlagBits::eTransient, self->device->getDefaultGraphicsQueueFamilyIndex() } );
+
+		// -- One command pool per execution context (worker thread) - we want at least one -
+		// plus one more pool for passes processed by threads outside the job system.
+		frameData.commandPools.resize( std::max<size_t>( 1, settings->concurrency_count ) + 1 );
+		for ( auto &pool : frameData.commandPools ) {
+			pool = vkDevice.createCommandPool( { vk::CommandPoolCreateFlagBits::eTransient, self->device->getDefaultGraphicsQueueFamilyIndex() } );
+		}
 
 		{
 			// -- set up an allocation pool for each frame
@@ -1637,7 +2043,14 @@ static bool backend_clear_frame( le_backend_o *self, size_t frameIndex ) {
 
 	// -- reset all frame-local sub-allocators
 	for ( auto &alloc : frame.allocators ) {
+		le_allocator_linear_stats_t stats_before;
+		le_allocator_linear_stats_t stats_after;
+		le_allocator_linear_i.get_stats( alloc, &stats_before );
 		le_allocator_linear_i.reset( alloc );
+		le_allocator_linear_i.get_stats( alloc, &stats_after );
+		if ( stats_after.block_count < stats_before.block_count ) {
+			self->descriptorCacheEpoch++; // allocator released buffers which cached descriptor sets may refer to
+		}
 	}
 
 	// -- reset frame-local staging allocator
@@ -1652,43 +2065,39 @@ static bool backend_clear_frame( le_backend_o *self, size_t frameIndex ) {
 	// -- remove any frame-local copy of allocated resources
 	frame.availableResources.clear();
 
-	for ( auto &d : frame.descriptorPools ) {
-		device.resetDescriptorPool( d );
-	}
-
 	{ // clear resources owned exclusively by this frame
 
-		for ( auto &r : frame.ownedResources ) {
-			switch ( r.type ) {
-			case AbstractPhysicalResource::eBuffer:
-				device.destroyBuffer( r.asBuffer );
-				break;
-			case AbstractPhysicalResource::eFramebuffer:
-				device.destroyFramebuffer( r.asFramebuffer );
-				break;
-			case AbstractPhysicalResource::eImage:
-				device.destroyImage( r.asImage );
-				break;
-			case AbstractPhysicalResource::eImageView:
-				device.destroyImageView( r.asImageView );
-				break;
-			case AbstractPhysicalResource::eRenderPass:
-				device.destroyRenderPass( r.asRenderPass );
-				break;
-			case AbstractPhysicalResource::eSampler:
-				device.destroySampler( r.asSampler );
-				break;
+		if ( !frame.ownedResources.empty() ) {
+			self->descriptorCacheEpoch++;
+		}
 
-			case AbstractPhysicalResource::eUndefined:
-				std::cout << __PRETTY_FUNCTION__ << ": abstract physical resource has unknown type (" << std::hex << r.type << ") and cannot be deleted. leaking..." << std::flush;
-				break;
-			}
+		for ( auto &r : frame.ownedResources ) {
+			abstract_physical_resource_destroy( device, r );
 		}
 		frame.ownedResources.clear();
 	}
 
-	device.freeCommandBuffers( frame.commandPool, frame.commandBuffers );
-	frame.commandBuffers.clear();
+	// -- release cached objects (renderpasses, framebuffers, image views, samplers) used by this frame
+	object_cache_release_frame_objects( &self->objectCache, device, frame );
+
+	{
+		// Return command buffers to the pools they were allocated from.
+		std::vector<vk::CommandBuffer> pool_command_buffers;
+		pool_command_buffers.reserve( frame.commandBuffers.size() );
+		for ( uint32_t p = 0; p != frame.commandPools.size(); ++p ) {
+			pool_command_buffers.clear();
+			for ( size_t i = 0; i != frame.commandBuffers.size(); ++i ) {
+				if ( frame.commandBufferPoolIndices[ i ] == p ) {
+					pool_command_buffers.push_back( frame.commandBuffers[ i ] );
+				}
+			}
+			if ( !pool_command_buffers.empty() ) {
+				device.freeCommandBuffers( frame.commandPools[ p ], pool_command_buffers );
+			}
+		}
+		frame.commandBuffers.clear();
+		frame.commandBufferPoolIndices.clear();
+	}
 
 	frame.physicalResources.clear();
 	frame.syncChainTable.clear();
@@ -1702,14 +2111,16 @@ static bool backend_clear_frame( le_backend_o *self, size_t frameIndex ) {
 	}
 	frame.passes.clear();
 
-	device.resetCommandPool( frame.commandPool, vk::CommandPoolResetFlagBits::eReleaseResources );
+	for ( auto &pool : frame.commandPools ) {
+		device.resetCommandPool( pool, vk::CommandPoolResetFlagBits::eReleaseResources );
+	}
 
 	return true;
 };
 
 // ----------------------------------------------------------------------
 
-static void backend_create_renderpasses( BackendFrameData &frame, vk::Device &device ) {
+static void backend_create_renderpasses( BackendFrameData &frame, vk::Device &device, le_vk_object_cache_o *objectCache ) {
 
 	// NOTE: we might be able to simplify this along the lines of
 	// <https://github.com/Tobski/simple_vulkan_synchronization>
@@ -2000,16 +2411,46 @@ static void backend_create_renderpasses( BackendFrameData &frame, vk::Device &de
 			    .setDependencyCount( uint32_t( dependencies.size() ) )
 			    .setPDependencies( dependencies.data() );
 
-			// Create vulkan renderpass object
-			pass.renderPass = device.createRenderPass( renderpassCreateInfo );
-
-			AbstractPhysicalResource rp;
-			rp.type         = AbstractPhysicalResource::eRenderPass;
-			rp.asRenderPass = pass.renderPass;
-
-			// Add vulkan renderpass object to list of owned and life-time tracked resources, so that
-			// it can be recycled when not needed anymore.
-			frame.ownedResources.emplace_front( std::move( rp ) );
+			// Renderpass objects are cached across frames - we must therefore build a cache
+			// key over everything that goes into renderpassCreateInfo, including
+			// load/store ops, layouts, and dependencies - in addition to what was
+			// factored into the hash for compatible renderpass.
+
+			static_assert( sizeof( vk::AttachmentDescription ) == 9 * sizeof( uint32_t ), "AttachmentDescription must be tightly packed for hashing" );
+			static_assert( sizeof( vk::AttachmentReference ) == 2 * sizeof( uint32_t ), "AttachmentReference must be tightly packed for hashing" );
+			static_assert( sizeof( vk::SubpassDependency ) == 7 * sizeof( uint32_t ), "SubpassDependency must be tightly packed for hashing" );
+
+			uint32_t const element_counts[ 4 ] = {
+			    uint32_t( attachments.size() ),
+			    uint32_t( colorAttachmentReferences.size() ),
+			    uint32_t( resolveAttachmentReferences.size() ),
+			    uint32_t( dsAttachmentReference ? 1 : 0 ),
+			};
+
+			std::vector<uint8_t> rp_key;
+			rp_key.reserve( sizeof( pass.renderpassHash ) + sizeof( element_counts ) +
+			                sizeof( vk::AttachmentDescription ) * attachments.size() +
+			                sizeof( vk::AttachmentReference ) * ( colorAttachmentReferences.size() + resolveAttachmentReferences.size() + 1 ) +
+			                sizeof( vk::SubpassDependency ) * dependencies.size() );
+
+			object_cache_key_append( rp_key, &pass.renderpassHash, sizeof( pass.renderpassHash ) );
+			object_cache_key_append( rp_key, element_counts, sizeof( element_counts ) );
+			object_cache_key_append( rp_key, attachments.data(), sizeof( vk::AttachmentDescription ) * attachments.size() );
+			object_cache_key_append( rp_key, colorAttachmentReferences.data(), sizeof( vk::AttachmentReference ) * colorAttachmentReferences.size() );
+			object_cache_key_append( rp_key, resolveAttachmentReferences.data(), sizeof( vk::AttachmentReference ) * resolveAttachmentReferences.size() );
+			if ( dsAttachmentReference ) {
+				object_cache_key_append( rp_key, dsAttachmentReference.get(), sizeof( vk::AttachmentReference ) );
+			}
+			object_cache_key_append( rp_key, dependencies.data(), sizeof( vk::SubpassDependency ) * dependencies.size() );
+
+			// Fetch vulkan renderpass object from cache - create it if not found.
+			pass.renderPass = object_cache_acquire( objectCache, frame, AbstractPhysicalResource::eRenderPass, rp_key.data(), rp_key.size(), nullptr, 0, [ & ]() {
+				                  AbstractPhysicalResource rp;
+				                  rp.type         = AbstractPhysicalResource::eRenderPass;
+				                  rp.asRenderPass = device.createRenderPass( renderpassCreateInfo );
+				                  return rp;
+			                  } )
+			                      .asRenderPass;
 		}
 	} // end for all passes
 }
@@ -2017,22 +2458,32 @@ static void backend_create_renderpasses( BackendFrameData &frame, vk::Device &de
 // ----------------------------------------------------------------------
 
 /// \brief fetch vk::Buffer from frame local storage based on resource handle flags
-/// - allocatorBuffers[index] if transient,
-/// - stagingAllocator.buffers[index] if staging,
+/// - allocator buffer if transient (allocator index in lower 8 bits, block index in upper 8 bits of index),
+/// - stagingAllocator allocation[index] if staging,
 /// otherwise, fetch from frame available resources based on an id lookup.
 static inline vk::Buffer frame_data_get_buffer_from_le_resource_id( const BackendFrameData &frame, const le_resource_handle_t &resource ) {
 
 	assert( resource.getResourceType() == LeResourceType::eBuffer ); // resource type must be buffer
 
 	if ( resource.getFlags() == le_resource_handle_t::FlagBits::eIsVirtual ) {
-		return frame.allocatorBuffers[ resource.getIndex() ];
+		return le_backend_vk::le_allocator_linear_i.get_block_buffer( frame.allocators[ resource.getIndex() & 0xff ], resource.getIndex() );
 	} else if ( resource.getFlags() == le_resource_handle_t::FlagBits::eIsStaging ) {
-		return frame.stagingAllocator->buffers[ resource.getIndex() ];
+		return staging_allocator_get_allocation( frame.stagingAllocator, resource.getIndex() )->buffer;
 	} else {
 		return frame.availableResources.at( resource ).as.buffer;
 	}
 }
 
+// ----------------------------------------------------------------------
+/// \brief offset at which memory for resource begins within the vk::Buffer returned
+/// by frame_data_get_buffer_from_le_resource_id - staging resources share buffers.
+static inline uint64_t frame_data_get_buffer_offset_from_le_resource_id( const BackendFrameData &frame, const le_resource_handle_t &resource ) {
+	if ( resource.getFlags() == le_resource_handle_t::FlagBits::eIsStaging ) {
+		return staging_allocator_get_allocation( frame.stagingAllocator, resource.getIndex() )->offset;
+	}
+	return 0;
+}
+
 // ----------------------------------------------------------------------
 static inline vk::Image frame_data_get_image_from_le_resource_id( const BackendFrameData &frame, const le_resource_handle_t &resource ) {
 
@@ -2082,10 +2533,44 @@ vk::ImageAspectFlags get_aspect_flags_from_format( vk::Format const &format ) {
 	return aspectFlags;
 }
 
+// ----------------------------------------------------------------------
+// Fetch image view from object cache - or create image view if not found.
+static vk::ImageView frame_acquire_image_view( BackendFrameData &frame, vk::Device const &device, le_vk_object_cache_o *objectCache, vk::ImageViewCreateInfo const &info ) {
+
+	static_assert( sizeof( vk::ComponentMapping ) == 4 * sizeof( uint32_t ), "ComponentMapping must be tightly packed for hashing" );
+	static_assert( sizeof( vk::ImageSubresourceRange ) == 5 * sizeof( uint32_t ), "ImageSubresourceRange must be tightly packed for hashing" );
+
+	VkImage image = info.image;
+
+	struct ImageViewKey {
+		VkImage                   image;
+		uint32_t                  view_info[ 3 ]; // flags, view type, format
+		vk::ComponentMapping      components;
+		vk::ImageSubresourceRange subresourceRange;
+	};
+
+	static_assert( sizeof( ImageViewKey ) == sizeof( VkImage ) + 12 * sizeof( uint32_t ), "ImageViewKey must be tightly packed for hashing" );
+
+	ImageViewKey const key = {
+	    image,
+	    { uint32_t( info.flags ), uint32_t( info.viewType ), uint32_t( info.format ) },
+	    info.components,
+	    info.subresourceRange,
+	};
+
+	return object_cache_acquire( objectCache, frame, AbstractPhysicalResource::eImageView, &key, sizeof( key ), &image, 1, [ & ]() {
+		       AbstractPhysicalResource iv;
+		       iv.type        = AbstractPhysicalResource::eImageView;
+		       iv.asImageView = device.createImageView( info );
+		       return iv;
+	       } )
+	    .asImageView;
+}
+
 // ----------------------------------------------------------------------
 // input: Pass
-// output: framebuffer, append newly created imageViews to retained resources list.
-static void backend_create_frame_buffers( BackendFrameData &frame, vk::Device &device ) {
+// output: framebuffer, using imageViews and framebuffers from object cache.
+static void backend_create_frame_buffers( BackendFrameData &frame, vk::Device &device, le_vk_object_cache_o *objectCache ) {
 
 	for ( auto &pass : frame.passes ) {
 
@@ -2098,7 +2583,9 @@ static void backend_create_frame_buffers( BackendFrameData &frame, vk::Device &d
 		                           pass.numDepthStencilAttachments;
 
 		std::vector<vk::ImageView> framebufferAttachments;
+		std::vector<VkImage>       framebufferImages; // images referenced by framebuffer attachments
 		framebufferAttachments.reserve( attachmentCount );
+		framebufferImages.reserve( attachmentCount );
 
 		auto const attachment_end = pass.attachments + attachmentCount;
 		for ( AttachmentInfo const *attachment = pass.attachments; attachment != attachment_end; attachment++ ) {
@@ -2119,20 +2606,8 @@ static void backend_create_frame_buffers( BackendFrameData &frame, vk::Device &d
 			    .setComponents( {} ) // default-constructor '{}' means identity
 			    .setSubresourceRange( subresourceRange );
 
-			auto imageView = device.createImageView( imageViewCreateInfo );
-
-			framebufferAttachments.push_back( imageView );
-
-			{
-				// Retain imageviews in owned resources - they will be released
-				// once not needed anymore.
-
-				AbstractPhysicalResource iv;
-				iv.type        = AbstractPhysicalResource::eImageView;
-				iv.asImageView = imageView;
-
-				frame.ownedResources.emplace_front( std::move( iv ) );
-			}
+			framebufferAttachments.push_back( frame_acquire_image_view( frame, device, objectCache, imageViewCreateInfo ) );
+			framebufferImages.push_back( imageViewCreateInfo.image );
 		}
 
 		vk::FramebufferCreateInfo framebufferCreateInfo;
@@ -2146,55 +2621,180 @@ static void backend_create_frame_buffers( BackendFrameData &frame, vk::Device &d
 		    .setHeight( pass.height )
 		    .setLayers( 1 );
 
-		pass.framebuffer = device.createFramebuffer( framebufferCreateInfo );
+		// Framebuffers are identified by their renderpass, their attachments, and their extents.
+		// Since attachment image views come from the object cache, they are unique per create info.
 
-		{
-			// Retain framebuffer
+		VkRenderPass   renderPass           = pass.renderPass;
+		uint32_t const framebuffer_info[ 2 ] = { pass.width, pass.height };
+
+		std::vector<uint8_t> fb_key;
+		fb_key.reserve( sizeof( VkRenderPass ) + sizeof( framebuffer_info ) + sizeof( vk::ImageView ) * framebufferAttachments.size() );
+
+		object_cache_key_append( fb_key, &renderPass, sizeof( VkRenderPass ) );
+		object_cache_key_append( fb_key, framebuffer_info, sizeof( framebuffer_info ) );
+		object_cache_key_append( fb_key, framebufferAttachments.data(), sizeof( vk::ImageView ) * framebufferAttachments.size() );
+
+		pass.framebuffer = object_cache_acquire( objectCache, frame, AbstractPhysicalResource::eFramebuffer, fb_key.data(), fb_key.size(), framebufferImages.data(), framebufferImages.size(), [ & ]() {
+			                   AbstractPhysicalResource fb;
+			                   fb.type          = AbstractPhysicalResource::eFramebuffer;
+			                   fb.asFramebuffer = device.createFramebuffer( framebufferCreateInfo );
+			                   return fb;
+		                   } )
+		                       .asFramebuffer;
+	}
+}
+
+// ----------------------------------------------------------------------
+
+static size_t descriptor_type_get_pool_index( vk::DescriptorType const &type ) {
+	for ( size_t i = 0; i != LE_DESCRIPTOR_TYPE_COUNT; ++i ) {
+		if ( LE_DESCRIPTOR_POOL_TYPES[ i ] == type ) {
+			return i;
+		}
+	}
+	assert( false && "descriptor type not supported by descriptor pools" );
+	return 0;
+}
+
+// ----------------------------------------------------------------------
+// Adds a descriptor pool to the cache - descriptor sets get allocated from this pool from now on.
+static void descriptor_cache_add_pool( le_descriptor_cache_o &cache, vk::Device const &device, uint32_t maxSets, std::array<uint32_t, LE_DESCRIPTOR_TYPE_COUNT> const &descriptorCounts ) {
+
+	std::array<vk::DescriptorPoolSize, LE_DESCRIPTOR_TYPE_COUNT> descriptorPoolSizes;
+
+	cache.poolMaxSets = std::max( maxSets, LE_DESCRIPTOR_POOL_MIN_SETS );
+
+	for ( size_t i = 0; i != LE_DESCRIPTOR_TYPE_COUNT; ++i ) {
+		cache.poolDescriptorCounts[ i ] = std::max( descriptorCounts[ i ], LE_DESCRIPTOR_POOL_MIN_DESCRIPTORS );
+		descriptorPoolSizes[ i ]        = { LE_DESCRIPTOR_POOL_TYPES[ i ], cache.poolDescriptorCounts[ i ] };
+	}
+
+	::vk::DescriptorPoolCreateInfo descriptorPoolCreateInfo;
+	descriptorPoolCreateInfo
+	    .setMaxSets( cache.poolMaxSets )
+	    .setPoolSizeCount( uint32_t( descriptorPoolSizes.size() ) )
+	    .setPPoolSizes( descriptorPoolSizes.data() );
 
-			AbstractPhysicalResource fb;
-			fb.type          = AbstractPhysicalResource::eFramebuffer;
-			fb.asFramebuffer = pass.framebuffer;
+	cache.pools.emplace_back( device.createDescriptorPool( descriptorPoolCreateInfo ) );
+}
+
+// ----------------------------------------------------------------------
+// Discards all cached descriptor sets. If we had to add pools since the last flush,
+// we replace all pools with a single pool which fits everything that was allocated
+// since the last flush.
+static void descriptor_cache_flush( le_descriptor_cache_o &cache, vk::Device const &device ) {
 
-			frame.ownedResources.emplace_front( std::move( fb ) );
+	if ( cache.pools.size() == 1 ) {
+		device.resetDescriptorPool( cache.pools.front() );
+	} else {
+		for ( auto &p : cache.pools ) {
+			device.destroyDescriptorPool( p );
 		}
+		cache.pools.clear();
+		descriptor_cache_add_pool( cache, device, cache.setsAllocated, cache.descriptorsAllocated );
+	}
+
+	cache.entries.clear();
+	cache.setsAllocated        = 0;
+	cache.descriptorsAllocated = {};
+}
+
+// ----------------------------------------------------------------------
+// Must be called before a descriptor cache gets used for a new frame.
+// `epoch` is the backend's current descriptor cache epoch.
+static void descriptor_cache_begin_frame( le_descriptor_cache_o &cache, vk::Device const &device, uint64_t epoch ) {
+
+	cache.frameNumber++;
+	cache.entriesUsedLastFrame = cache.entriesUsed;
+	cache.entriesUsed          = 0;
+	cache.statsSetsAllocated   = 0;
+	cache.statsSetsReused      = 0;
+
+	if ( cache.epoch != epoch ||
+	     cache.entries.size() > 2 * cache.entriesUsedLastFrame + LE_DESCRIPTOR_CACHE_MAX_UNUSED ) {
+		descriptor_cache_flush( cache, device );
+		cache.epoch = epoch;
 	}
 }
 
 // ----------------------------------------------------------------------
+// Allocates a descriptor set from the cache's current pool - adds a new pool if the current pool is exhausted.
+static vk::DescriptorSet descriptor_cache_allocate_set( le_descriptor_cache_o &cache, vk::Device const &device, vk::DescriptorSetLayout const &setLayout, std::vector<DescriptorData> const &setData ) {
 
-static void backend_create_descriptor_pools( BackendFrameData &frame, vk::Device &device, size_t numRenderPasses ) {
+	std::array<uint32_t, LE_DESCRIPTOR_TYPE_COUNT> setDescriptorCounts{};
 
-	// Make sure that there is one descriptorpool for every renderpass.
-	// descriptor pools which were created previously will be re-used,
-	// if we're suddenly rendering more frames, we will add additional
-	// descriptorPools.
+	for ( auto const &d : setData ) {
+		setDescriptorCounts[ descriptor_type_get_pool_index( d.type ) ]++;
+	}
 
-	// at this point it would be nice to have an idea for each renderpass
-	// on how many descriptors to expect, but we cannot know that realistically
-	// without going through the command buffer... yuck.
+	vk::DescriptorSetAllocateInfo allocateInfo;
+	allocateInfo.setDescriptorPool( cache.pools.back() )
+	    .setDescriptorSetCount( 1 )
+	    .setPSetLayouts( &setLayout );
 
-	// this is why we're creating space for a generous amount of descriptors
-	// hoping we're not running out when assembling the command buffer.
+	vk::DescriptorSet descriptorSet;
 
-	for ( ; frame.descriptorPools.size() < numRenderPasses; ) {
+	auto result = device.allocateDescriptorSets( &allocateInfo, &descriptorSet );
 
-		std::vector<::vk::DescriptorPoolSize> descriptorPoolSizes;
+	if ( result == vk::Result::eErrorOutOfPoolMemory || result == vk::Result::eErrorFragmentedPool ) {
 
-		descriptorPoolSizes.reserve( VK_DESCRIPTOR_TYPE_RANGE_SIZE );
+		// Current pool is exhausted - add a pool of twice its size (and large enough to hold at least this set).
 
-		for ( size_t i = VK_DESCRIPTOR_TYPE_BEGIN_RANGE; i != VK_DESCRIPTOR_TYPE_BEGIN_RANGE + VK_DESCRIPTOR_TYPE_RANGE_SIZE; ++i ) {
-			descriptorPoolSizes.emplace_back( ::vk::DescriptorType( i ), 1000 ); // 1000 descriptors of each type
+		std::array<uint32_t, LE_DESCRIPTOR_TYPE_COUNT> descriptorCounts;
+		for ( size_t i = 0; i != LE_DESCRIPTOR_TYPE_COUNT; ++i ) {
+			descriptorCounts[ i ] = 2 * std::max( cache.poolDescriptorCounts[ i ], setDescriptorCounts[ i ] );
 		}
 
-		::vk::DescriptorPoolCreateInfo descriptorPoolCreateInfo;
-		descriptorPoolCreateInfo
-		    .setMaxSets( 2000 )
-		    .setPoolSizeCount( uint32_t( descriptorPoolSizes.size() ) )
-		    .setPPoolSizes( descriptorPoolSizes.data() );
+		descriptor_cache_add_pool( cache, device, 2 * cache.poolMaxSets, descriptorCounts );
+
+		allocateInfo.setDescriptorPool( cache.pools.back() );
+		result = device.allocateDescriptorSets( &allocateInfo, &descriptorSet );
+	}
+
+	assert( result == vk::Result::eSuccess && "failed to allocate descriptor set" );
+
+	cache.setsAllocated++;
+	cache.statsSetsAllocated++;
+
+	for ( size_t i = 0; i != LE_DESCRIPTOR_TYPE_COUNT; ++i ) {
+		cache.descriptorsAllocated[ i ] += setDescriptorCounts[ i ];
+	}
+
+	return descriptorSet;
+}
+
+// ----------------------------------------------------------------------
+// Hash over set layout and descriptor data - note that we hash the same bytes which
+// DescriptorData::operator== compares.
+static uint64_t descriptor_set_hash( vk::DescriptorSetLayout const &setLayout, std::vector<DescriptorData> const &setData ) {
+
+	VkDescriptorSetLayout layout = setLayout;
+	uint64_t              hash   = SpookyHash::Hash64( &layout, sizeof( layout ), 0 );
+
+	for ( auto const &d : setData ) {
+		hash = SpookyHash::Hash64( &d, offsetof( DescriptorData, arrayIndex ) + sizeof( d.arrayIndex ), hash );
+		hash = SpookyHash::Hash64( d.data, sizeof( d.data ), hash );
+	}
+
+	return hash;
+}
+
+// ----------------------------------------------------------------------
+
+static void backend_create_descriptor_caches( BackendFrameData &frame, vk::Device &device, size_t numRenderPasses ) {
 
-		vk::DescriptorPool descriptorPool = device.createDescriptorPool( descriptorPoolCreateInfo );
+	// Make sure that there is one descriptor cache for every renderpass.
+	// Descriptor caches which were created previously will be re-used,
+	// if we're suddenly rendering more passes, we will add additional
+	// descriptor caches.
+	//
+	// We can't know up-front how many descriptors to expect for each pass - this
+	// is why pools start out small, and grow based on what we observe once we
+	// go through the command buffer.
 
-		frame.descriptorPools.emplace_back( std::move( descriptorPool ) );
+	for ( ; frame.descriptorCaches.size() < numRenderPasses; ) {
+		frame.descriptorCaches.emplace_back();
+		descriptor_cache_add_pool( frame.descriptorCaches.back(), device, LE_DESCRIPTOR_POOL_MIN_SETS, {} );
 	}
 }
 
@@ -2238,6 +2838,8 @@ static int32_t backend_allocate_image( le_backend_o *                 self,
 // ----------------------------------------------------------------------
 
 static void backend_destroy_image( le_backend_o *self, VkImage image, VmaAllocation allocation ) {
+	self->descriptorCacheEpoch++;
+	object_cache_evict_images( &self->objectCache, self->device->getVkDevice(), &image, 1 );
 	vmaDestroyImage( self->mAllocator, image, allocation );
 }
 
@@ -2256,6 +2858,7 @@ static int32_t backend_allocate_buffer( le_backend_o *                 self,
 // ----------------------------------------------------------------------
 
 static void backend_destroy_buffer( le_backend_o *self, VkBuffer buffer, VmaAllocation allocation ) {
+	self->descriptorCacheEpoch++;
 	vmaDestroyBuffer( self->mAllocator, buffer, allocation );
 }
 
@@ -2455,24 +3058,9 @@ static le_staging_allocator_o *staging_allocator_create( VmaAllocator const vmaA
 
 // ----------------------------------------------------------------------
 
-// Allocates a chunk of memory from the vulkan free store via vmaAlloc, and maps it
-// for writing at *pData.
-//
-// If successful, `resource_handle` receives a valid `le_resource_handle` referring to
-// this particular chunk of staging memory.
-//
-// Returns false on error, true on success.
-//
-// Staging memory is only allowed to be used for staging, that is, only
-// TRANSFER_SRC are set for usage flags.
-//
-// Staging memory is typically cache coherent, ie. does not need to be flushed.
-static bool staging_allocator_map( le_staging_allocator_o *self, uint64_t numBytes, void **pData, le_resource_handle_t *resource_handle ) {
+// Creates a persistently mapped buffer of `numBytes` for use as a staging buffer.
+static bool staging_allocator_create_buffer( le_staging_allocator_o *self, uint64_t numBytes, VkBuffer *buffer, VmaAllocation *allocation, void **pData ) {
 
-	auto lock = std::scoped_lock( self->mtx );
-
-	VmaAllocation     allocation; // handle to allocation
-	VkBuffer          buffer;     // handle to buffer (returned from vmaMemAlloc)
 	VmaAllocationInfo allocationInfo;
 
 	VkBufferCreateInfo bufferCreateInfo = vk::BufferCreateInfo()
@@ -2488,8 +3076,8 @@ static bool staging_allocator_map( le_staging_allocator_o *self, uint64_t numByt
 	auto result = vmaCreateBuffer( self->allocator,
 	                               &bufferCreateInfo,
 	                               &allocationCreateInfo,
-	                               &buffer,
-	                               &allocation,
+	                               buffer,
+	                               allocation,
 	                               &allocationInfo );
 
 	assert( result == VK_SUCCESS );
@@ -2498,38 +3086,176 @@ static bool staging_allocator_map( le_staging_allocator_o *self, uint64_t numByt
 		return false;
 	}
 
-	{
-		// -- Now store our allocation in the allocations vectors.
-		//
-		// We need to lock the mutex as we are updating all vectors
-		// and this might lead to re-allocations.
-		//
-		// Other encoders might also want to map memory, and
-		// they will have to wait for whichever operation in
-		// process to finish.
+	*pData = allocationInfo.pMappedData;
+
+	self->statsDriverAllocations++;
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+// Replaces `exhausted_block` as the current block with a fresh block - either
+// one which is available for re-use, or a newly created one.
+//
+// Returns false if no new block could be created.
+static bool staging_allocator_replace_block( le_staging_allocator_o *self, le_staging_block_t *exhausted_block ) {
+
+	auto lock = std::scoped_lock( self->mtx );
+
+	if ( self->currentBlock.load( std::memory_order_relaxed ) != exhausted_block ) {
+		// Another thread has replaced this block while we were waiting for the lock.
+		return true;
+	}
+
+	le_staging_block_t *block = nullptr;
+
+	if ( !self->freeBlocks.empty() ) {
+		block = self->freeBlocks.back();
+		self->freeBlocks.pop_back();
+		block->offset = 0;
+	} else {
+		block       = new le_staging_block_t{};
+		block->size = LE_STAGING_BLOCK_SIZE;
+
+		void *data = nullptr;
+
+		if ( !staging_allocator_create_buffer( self, block->size, &block->buffer, &block->allocation, &data ) ) {
+			delete block;
+			return false;
+		}
+
+		block->data = static_cast<char *>( data );
+	}
+
+	self->blocks.push_back( block );
+	self->currentBlock.store( block, std::memory_order_release );
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+// Returns storage for staging allocation at `index` - creates storage if needed.
+// Returns nullptr if `index` is out of range.
+static le_staging_allocation_t *staging_allocator_emplace_allocation( le_staging_allocator_o *self, uint32_t index ) {
+
+	uint32_t chunk_index = index / LE_STAGING_ALLOCATIONS_PER_CHUNK;
+
+	if ( chunk_index >= LE_STAGING_ALLOCATION_CHUNKS_COUNT ) {
+		return nullptr;
+	}
+
+	auto &chunk       = self->allocationChunks[ chunk_index ];
+	auto  allocations = chunk.load( std::memory_order_acquire );
+
+	if ( nullptr == allocations ) {
+		auto lock   = std::scoped_lock( self->mtx );
+		allocations = chunk.load( std::memory_order_relaxed );
+		if ( nullptr == allocations ) {
+			allocations = new le_staging_allocation_t[ LE_STAGING_ALLOCATIONS_PER_CHUNK ];
+			chunk.store( allocations, std::memory_order_release );
+		}
+	}
+
+	return allocations + ( index % LE_STAGING_ALLOCATIONS_PER_CHUNK );
+}
+
+// ----------------------------------------------------------------------
+
+// Allocates a chunk of staging memory, which is mapped for writing at *pData.
+//
+// If successful, `resource_handle` receives a valid `le_resource_handle` referring to
+// this particular chunk of staging memory.
+//
+// Returns false on error, true on success.
+//
+// Staging memory is only allowed to be used for staging, that is, only
+// TRANSFER_SRC are set for usage flags.
+//
+// Staging memory is typically cache coherent, ie. does not need to be flushed.
+//
+// Memory is sub-allocated from the current staging block via an atomic bump pointer,
+// which means that encoders on different threads may map memory without taking a lock.
+// Allocations which are too large to share a block are placed in a dedicated buffer.
+static bool staging_allocator_map( le_staging_allocator_o *self, uint64_t numBytes, void **pData, le_resource_handle_t *resource_handle ) {
+
+	auto t_start = std::chrono::steady_clock::now();
+
+	VkBuffer buffer = nullptr;
+	uint64_t offset = 0;
+	void *   data   = nullptr;
+
+	if ( numBytes > LE_STAGING_DEDICATED_THRESHOLD ) {
+
+		VmaAllocation allocation;
+
+		if ( !staging_allocator_create_buffer( self, numBytes, &buffer, &allocation, &data ) ) {
+			return false;
+		}
+
+		auto lock = std::scoped_lock( self->mtx );
+		self->dedicatedBuffers.push_back( buffer );
+		self->dedicatedAllocations.push_back( allocation );
+
+	} else {
+
+		// Note that LE_STAGING_ALIGNMENT is not a power of two.
+		uint64_t const allocationSize = ( ( numBytes + LE_STAGING_ALIGNMENT - 1 ) / LE_STAGING_ALIGNMENT ) * LE_STAGING_ALIGNMENT;
+
+		for ( ;; ) {
+			auto block = self->currentBlock.load( std::memory_order_acquire );
+
+			if ( block ) {
+				offset = block->offset.fetch_add( allocationSize, std::memory_order_relaxed );
+				if ( offset + allocationSize <= block->size ) {
+					buffer = block->buffer;
+					data   = block->data + offset;
+					break;
+				}
+			}
 
-		size_t allocationIndex = self->allocations.size();
+			// ---------| invariant: no block, or block exhausted
 
-		self->allocations.push_back( allocation );
-		self->allocationInfo.push_back( allocationInfo );
-		self->buffers.push_back( buffer );
+			if ( !staging_allocator_replace_block( self, block ) ) {
+				return false;
+			}
+		}
+	}
 
-		// Virtual resources all share the same id,
-		// but their meta data is different.
-		auto resource = LE_BUF_RESOURCE( "Le-Staging-Buffer" );
+	// -- Store where memory for this allocation lives, so that the backend
+	//    may find buffer and offset for this allocation via its resource handle.
 
-		// We store the allocation index in the resource handle meta data
-		// so that the correct buffer for this handle can be retrieved later.
-		resource.handle.as_handle.meta.as_meta.index = uint16_t( allocationIndex );
-		resource.handle.as_handle.meta.as_meta.flags = le_resource_handle_t::FlagBits::eIsStaging;
+	uint32_t allocationIndex = self->allocationsCount.fetch_add( 1, std::memory_order_relaxed );
+	auto     allocation      = staging_allocator_emplace_allocation( self, allocationIndex );
 
-		// Store the handle for this resource so that the caller
-		// may receive it.
-		*resource_handle = resource;
+	if ( nullptr == allocation ) {
+		std::cerr << "ERROR: Too many staging allocations for this frame." << std::endl
+		          << std::flush;
+		return false;
 	}
 
-	// Map memory so that it may be written to
-	vmaMapMemory( self->allocator, allocation, pData );
+	allocation->buffer = buffer;
+	allocation->offset = offset;
+
+	// Virtual resources all share the same id,
+	// but their meta data is different.
+	auto resource = LE_BUF_RESOURCE( "Le-Staging-Buffer" );
+
+	// We store the allocation index in the resource handle meta data
+	// so that the correct buffer for this handle can be retrieved later.
+	resource.handle.as_handle.meta.as_meta.index = uint16_t( allocationIndex );
+	resource.handle.as_handle.meta.as_meta.flags = le_resource_handle_t::FlagBits::eIsStaging;
+
+	// Store the handle for this resource so that the caller
+	// may receive it.
+	*resource_handle = resource;
+
+	*pData = data;
+
+	self->statsBytesStaged += numBytes;
+	self->statsAllocationsCount++;
+	self->statsMapNanoseconds += uint64_t( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - t_start ).count() );
 
 	return true;
 };
@@ -2537,26 +3263,47 @@ static bool staging_allocator_map( le_staging_allocator_o *self, uint64_t numByt
 // ----------------------------------------------------------------------
 
 /// Frees all allocations held by the staging allocator given in `self`
+/// Blocks are kept for re-use with the next frame which uses this allocator.
 static void staging_allocator_reset( le_staging_allocator_o *self ) {
-	auto lock   = std::scoped_lock( self->mtx );
-	auto device = vk::Device{ self->device };
+	auto lock = std::scoped_lock( self->mtx );
 
-	assert( self->buffers.size() == self->allocations.size() && self->buffers.size() == self->allocationInfo.size() &&
-	        "buffers, allocations, and allocationInfos sizes must match." );
+	assert( self->dedicatedBuffers.size() == self->dedicatedAllocations.size() &&
+	        "buffers, and allocations sizes must match." );
 
 	// Since buffers were allocated using the VMA allocator,
 	// we cannot delete them directly using the device. We must delete them using the allocator,
 	// so that the allocator can track current allocations.
 
-	auto allocation = self->allocations.begin();
-	for ( auto b = self->buffers.begin(); b != self->buffers.end(); b++, allocation++ ) {
-		vmaUnmapMemory( self->allocator, *allocation );
+	auto allocation = self->dedicatedAllocations.begin();
+	for ( auto b = self->dedicatedBuffers.begin(); b != self->dedicatedBuffers.end(); b++, allocation++ ) {
 		vmaDestroyBuffer( self->allocator, *b, *allocation ); // implicitly calls vmaFreeMemory()
 	}
 
-	self->buffers.clear();
-	self->allocations.clear();
-	self->allocationInfo.clear();
+	self->dedicatedBuffers.clear();
+	self->dedicatedAllocations.clear();
+
+	// -- Blocks which were not needed with this frame are given back - but we always keep
+	//    at least one block, so that frames with few uploads don't cause driver allocations.
+
+	if ( self->blocks.empty() && !self->freeBlocks.empty() ) {
+		self->blocks.push_back( self->freeBlocks.back() );
+		self->freeBlocks.pop_back();
+	}
+
+	for ( auto &b : self->freeBlocks ) {
+		vmaDestroyBuffer( self->allocator, b->buffer, b->allocation );
+		delete b;
+	}
+
+	self->freeBlocks.swap( self->blocks );
+	self->blocks.clear();
+
+	for ( auto &b : self->freeBlocks ) {
+		b->offset = 0;
+	}
+
+	self->currentBlock     = nullptr;
+	self->allocationsCount = 0;
 }
 
 // ----------------------------------------------------------------------
@@ -2567,21 +3314,46 @@ static void staging_allocator_destroy( le_staging_allocator_o *self ) {
 	// Reset the object first so that dependent objects (vmaAllocations, vulkan objects) are cleaned up.
 	staging_allocator_reset( self );
 
+	for ( auto &b : self->freeBlocks ) {
+		vmaDestroyBuffer( self->allocator, b->buffer, b->allocation );
+		delete b;
+	}
+	self->freeBlocks.clear();
+
+	for ( auto &c : self->allocationChunks ) {
+		delete[] c.load();
+	}
+
+	if ( self->statsAllocationsCount ) {
+		double map_ms = double( self->statsMapNanoseconds ) / 1'000'000.0;
+		std::cout << "Staging allocator: " << std::dec << self->statsAllocationsCount << " allocations, "
+		          << std::fixed << std::setprecision( 2 ) << double( self->statsBytesStaged ) / double( 1 << 20 ) << "MiB staged, "
+		          << self->statsDriverAllocations << " vma buffers created, " << map_ms << "ms in map" << std::endl
+		          << std::flush;
+	}
+
 	delete self;
 }
 
 // ----------------------------------------------------------------------
 
 // Frees any resources which are marked for being recycled in the current frame.
-inline void frame_release_binned_resources( BackendFrameData &frame, vk::Device device, VmaAllocator &allocator ) {
+inline void frame_release_binned_resources( BackendFrameData &frame, vk::Device device, VmaAllocator &allocator, le_vk_object_cache_o *objectCache ) {
 	for ( auto &a : frame.binnedResources ) {
 		if ( a.second.info.isBuffer() ) {
 			vmaDestroyBuffer( allocator, a.second.as.buffer, a.second.allocation );
 		} else {
+			object_cache_evict_images( objectCache, device, &a.second.as.image, 1 );
 			vmaDestroyImage( allocator, a.second.as.image, a.second.allocation );
 		}
 	}
 	frame.binnedResources.clear();
+
+	// Binned allocations may hold memory for binned resources, so we free them last.
+	for ( auto &a : frame.binnedAllocations ) {
+		vmaFreeMemory( allocator, a );
+	}
+	frame.binnedAllocations.clear();
 }
 
 // ----------------------------------------------------------------------
@@ -2797,6 +3569,7 @@ static void consolidate_resource_infos(
 
 			first_info->image.flags |= info->image.flags;
 			first_info->image.usage |= info->image.usage;
+			first_info->image.is_transient |= info->image.is_transient;
 			first_info->image.samplesFlags |= uint32_t( 1 << info->image.sample_count_log2 );
 
 			// If an image format was explictly set, this takes precedence over eUndefined.
@@ -3036,6 +3809,409 @@ static void frame_resources_set_debug_names( le_backend_vk_instance_o *instance,
 	}
 }
 
+// ----------------------------------------------------------------------
+// Range of passes over which a resource is used within a frame.
+struct le_resource_lifetime_t {
+	le_resource_handle_t resource_id;
+	uint32_t             first_pass;   // index of first pass using resource
+	uint32_t             last_pass;    // index of last pass using resource
+	bool                 is_transient; // whether first use discards any previous contents of resource
+};
+
+// ----------------------------------------------------------------------
+// Collects lifetimes for all image resources used by passes. Passes are given in
+// execution order, so that pass indices tell us in which order images get accessed.
+//
+// An image is transient if its first use is as an attachment which does not load its
+// previous contents - contents from earlier frames are therefore never observed.
+static void collect_image_lifetimes( le_renderpass_o **passes, size_t numRenderPasses, std::vector<le_resource_lifetime_t> &lifetimes ) {
+
+	using namespace le_renderer;
+
+	auto use_image = [ &lifetimes ]( le_resource_handle_t const &resource, uint32_t pass_index, bool discards_contents ) {
+		auto it = std::find_if( lifetimes.begin(), lifetimes.end(), [ &resource ]( le_resource_lifetime_t const &l ) { return l.resource_id == resource; } );
+		if ( it == lifetimes.end() ) {
+			lifetimes.push_back( { resource, pass_index, pass_index, discards_contents } );
+		} else {
+			it->last_pass = pass_index;
+		}
+	};
+
+	for ( uint32_t pass_index = 0; pass_index != numRenderPasses; pass_index++ ) {
+
+		auto pass           = passes[ pass_index ];
+		auto numSamplesLog2 = get_sample_count_log_2( uint32_t( renderpass_i.get_sample_count( pass ) ) );
+
+		// We must look at attachments first, as only they tell us whether an image is loaded.
+
+		le_image_attachment_info_t const *pImageAttachments   = nullptr;
+		le_resource_handle_t const *      pResources          = nullptr;
+		size_t                            numImageAttachments = 0;
+
+		renderpass_i.get_image_attachments( pass, &pImageAttachments, &pResources, &numImageAttachments );
+
+		for ( size_t i = 0; i != numImageAttachments; ++i ) {
+
+			// Patch number of samples into resource id, just as le_renderpass_add_attachments does.
+			auto image_resource_id                                      = pResources[ i ];
+			image_resource_id.handle.as_handle.meta.as_meta.num_samples = numSamplesLog2;
+
+			use_image( image_resource_id, pass_index, pImageAttachments[ i ].loadOp != le::AttachmentLoadOp::eLoad );
+
+			if ( numSamplesLog2 != 0 ) {
+				// Multisampled passes resolve into the single-sampled version of an attachment,
+				// which overwrites the single-sampled version's contents.
+				image_resource_id.handle.as_handle.meta.as_meta.num_samples = 0;
+				use_image( image_resource_id, pass_index, true );
+			}
+		}
+
+		le_resource_handle_t const *resources       = nullptr;
+		LeResourceUsageFlags const *resources_usage = nullptr;
+		size_t                      resources_count = 0;
+
+		renderpass_i.get_used_resources( pass, &resources, &resources_usage, &resources_count );
+
+		for ( size_t i = 0; i != resources_count; ++i ) {
+			if ( resources_usage[ i ].type == LeResourceType::eImage ) {
+				use_image( resources[ i ], pass_index, false );
+			}
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+// Places transient images used by the frame into the backend's transient heap, so that
+// images with non-overlapping lifetimes share memory. Images placed into the heap are
+// added to backend resources, where backend_allocate_resources picks them up just as if
+// they had been allocated individually.
+//
+// If the current heap layout does not fit the frame's transient images, we create a new
+// heap layout, which holds the frame's transient images plus any images from the current
+// layout which are not used by this frame. All images placed into the current heap get
+// binned together with the heap.
+static void backend_alias_transient_images( le_backend_o *                                      self,
+                                            BackendFrameData &                                  frame,
+                                            std::vector<le_resource_handle_t> const &           usedResources,
+                                            std::vector<std::vector<le_resource_info_t>> const &usedResourcesInfos,
+                                            std::vector<le_resource_lifetime_t> const &         lifetimes ) {
+
+	auto &backendResources = self->only_backend_allocate_resources_may_access.allocatedResources;
+	auto &heap             = self->only_backend_allocate_resources_may_access.transientHeap;
+
+	frame.aliasedResources.clear();
+
+	using Entry = le_transient_heap_t::Entry;
+
+	auto share_memory = []( Entry const &lhs, Entry const &rhs ) -> bool {
+		return lhs.offset < rhs.offset + rhs.size && rhs.offset < lhs.offset + lhs.size;
+	};
+
+	auto share_passes = []( Entry const &lhs, Entry const &rhs ) -> bool {
+		return lhs.first_pass <= rhs.last_pass && rhs.first_pass <= lhs.last_pass;
+	};
+
+	auto is_used_by_frame = [ &usedResources ]( le_resource_handle_t const &resourceId ) -> bool {
+		return usedResources.end() != std::find( usedResources.begin(), usedResources.end(), resourceId );
+	};
+
+	// -- Collect transient images used in this frame.
+
+	struct Candidate {
+		le_resource_handle_t resource_id;
+		size_t               resource_index; // index into usedResources, or size_t( ~0 ) if image is not used by this frame
+		ResourceCreateInfo   info;           // requested create info
+		uint32_t             first_pass;
+		uint32_t             last_pass;
+	};
+
+	std::vector<Candidate> candidates;
+
+	for ( size_t i = 0; i != usedResources.size(); ++i ) {
+
+		auto const &resourceId = usedResources[ i ];
+
+		if ( resourceId.getResourceType() != LeResourceType::eImage ||
+		     frame.availableResources.find( resourceId ) != frame.availableResources.end() ) {
+			// Not an image, or an image which is managed elsewhere (e.g. swapchain image)
+			continue;
+		}
+
+		if ( !usedResourcesInfos[ i ][ 0 ].image.is_transient ) {
+			// Only images which were explicitly declared transient may lose their contents between frames.
+			continue;
+		}
+
+		auto lifetime = std::find_if( lifetimes.begin(), lifetimes.end(), [ &resourceId ]( le_resource_lifetime_t const &l ) { return l.resource_id == resourceId; } );
+
+		if ( lifetime == lifetimes.end() || !lifetime->is_transient ) {
+			continue;
+		}
+
+		auto resourceCreateInfo = ResourceCreateInfo::from_le_resource_info( usedResourcesInfos[ i ][ 0 ], &self->queueFamilyIndexGraphics, 0 );
+
+		if ( resourceCreateInfo.imageInfo.tiling != VK_IMAGE_TILING_OPTIMAL ) {
+			// Linear images would have to respect bufferImageGranularity when placed next to optimal images.
+			continue;
+		}
+
+		candidates.push_back( { resourceId, i, resourceCreateInfo, lifetime->first_pass, lifetime->last_pass } );
+	}
+
+	// -- Check whether current heap layout still fits: it must hold all candidates, created
+	// with compatible infos, images which share memory must not share passes, and any image
+	// in the heap which is used by this frame must be a candidate.
+
+	for ( auto &e : heap.entries ) {
+		e.in_use = false;
+	}
+
+	bool isLayoutValid = true;
+
+	for ( auto c = candidates.begin(); isLayoutValid && c != candidates.end(); c++ ) {
+
+		auto entry = std::find_if( heap.entries.begin(), heap.entries.end(), [ &c ]( Entry const &e ) { return e.resource_id == c->resource_id; } );
+
+		if ( entry != heap.entries.end() ) {
+			isLayoutValid     = ( entry->info >= c->info );
+			entry->first_pass = c->first_pass;
+			entry->last_pass  = c->last_pass;
+			entry->in_use     = true;
+		} else {
+			isLayoutValid = ( heap.unplaced.end() != std::find( heap.unplaced.begin(), heap.unplaced.end(), c->resource_id ) );
+		}
+	}
+
+	for ( size_t i = 0; isLayoutValid && i != heap.entries.size(); i++ ) {
+		if ( !heap.entries[ i ].in_use ) {
+			// An image which shares memory with other images may only be used as a transient image.
+			isLayoutValid = !is_used_by_frame( heap.entries[ i ].resource_id );
+			continue;
+		}
+		for ( size_t j = i + 1; isLayoutValid && j != heap.entries.size(); j++ ) {
+			isLayoutValid = !( heap.entries[ j ].in_use &&
+			                   share_memory( heap.entries[ i ], heap.entries[ j ] ) &&
+			                   share_passes( heap.entries[ i ], heap.entries[ j ] ) );
+		}
+	}
+
+	if ( !isLayoutValid ) {
+
+		// -- Images from the current layout which are not used by this frame keep a place in the
+		// new layout, so that a frame which uses them again does not force yet another layout.
+		// As we can't tell which passes will use them, they must not share memory with any image.
+		//
+		// Images which are used by this frame, but are not candidates, get allocated individually
+		// once we have binned their heap versions.
+
+		for ( auto const &e : heap.entries ) {
+			if ( !e.in_use && !is_used_by_frame( e.resource_id ) ) {
+				candidates.push_back( { e.resource_id, size_t( ~0 ), e.info, 0, uint32_t( ~0 ) } );
+			}
+		}
+
+		// -- Bin all images placed into the current heap, and the heap itself. We can't free
+		// them immediately, as frames which are still in flight might use them.
+
+		for ( auto const &e : heap.entries ) {
+			auto it = backendResources.find( e.resource_id );
+			if ( it != backendResources.end() ) {
+				frame.binnedResources.try_emplace( e.resource_id, it->second );
+				backendResources.erase( it );
+			}
+		}
+
+		if ( heap.allocation ) {
+			frame.binnedAllocations.push_back( heap.allocation );
+		}
+
+		auto previouslyUnplaced = std::move( heap.unplaced );
+
+		heap = {};
+
+		// Images which could not be placed, and are not used by this frame, stay allocated individually.
+		for ( auto const &resourceId : previouslyUnplaced ) {
+			if ( !is_used_by_frame( resourceId ) ) {
+				heap.unplaced.push_back( resourceId );
+			}
+		}
+
+		// -- Create images, and find out about their memory requirements.
+
+		vk::Device device( self->device->getVkDevice() );
+
+		std::vector<Entry>     entries;
+		std::vector<vk::Image> images;     // one per entry
+		std::vector<uint64_t>  alignments; // one per entry
+		uint64_t               heapAlignment  = 1;
+		uint32_t               memoryTypeBits = ~0u;
+
+		for ( auto const &c : candidates ) {
+
+			auto resourceCreateInfo = c.info;
+
+			if ( c.resource_index != size_t( ~0 ) ) {
+
+				patchImageUsageForMipLevels( &resourceCreateInfo );
+
+				if ( resourceCreateInfo.imageInfo.format == VK_FORMAT_UNDEFINED ) {
+					inferImageFormat( self, c.resource_id, usedResourcesInfos[ c.resource_index ][ 0 ].image.usage, &resourceCreateInfo );
+				}
+			}
+
+			vk::Image              image        = device.createImage( vk::ImageCreateInfo( resourceCreateInfo.imageInfo ) );
+			vk::MemoryRequirements requirements = device.getImageMemoryRequirements( image );
+
+			if ( 0 == ( memoryTypeBits & requirements.memoryTypeBits ) ) {
+				// Image can't live in the same memory as images we have seen so far.
+				device.destroyImage( image );
+				heap.unplaced.push_back( c.resource_id );
+				continue;
+			}
+
+			memoryTypeBits &= requirements.memoryTypeBits;
+			heapAlignment = std::max<uint64_t>( heapAlignment, requirements.alignment );
+
+			entries.push_back( { c.resource_id, resourceCreateInfo, 0, requirements.size, c.first_pass, c.last_pass, c.resource_index != size_t( ~0 ) } );
+			images.push_back( image );
+			alignments.push_back( requirements.alignment );
+		}
+
+		// -- Place images, largest first. Each image goes to the lowest offset at which
+		// it does not share memory with any image placed before it with which it shares passes.
+
+		std::vector<size_t> placement_order( entries.size() );
+		for ( size_t i = 0; i != entries.size(); i++ ) {
+			placement_order[ i ] = i;
+		}
+		std::stable_sort( placement_order.begin(), placement_order.end(), [ &entries ]( size_t lhs, size_t rhs ) {
+			return entries[ lhs ].size > entries[ rhs ].size;
+		} );
+
+		std::vector<Entry const *> placed;    // sorted by offset
+		std::vector<Entry const *> conflicts; // placed entries which share passes with current entry, sorted by offset
+
+		for ( auto const &i : placement_order ) {
+
+			auto &   entry     = entries[ i ];
+			uint64_t alignment = alignments[ i ];
+			uint64_t offset    = 0;
+
+			conflicts.clear();
+			for ( auto const &p : placed ) {
+				if ( share_passes( *p, entry ) ) {
+					conflicts.push_back( p );
+				}
+			}
+
+			for ( auto const &p : conflicts ) {
+				offset = ( ( offset + alignment - 1 ) / alignment ) * alignment;
+				if ( offset + entry.size <= p->offset ) {
+					break; // found a gap
+				}
+				offset = std::max( offset, p->offset + p->size );
+			}
+
+			entry.offset = ( ( offset + alignment - 1 ) / alignment ) * alignment;
+			heap.size    = std::max( heap.size, entry.offset + entry.size );
+
+			placed.insert( std::upper_bound( placed.begin(), placed.end(), entry.offset, []( uint64_t offset, Entry const *p ) { return offset < p->offset; } ), &entry );
+		}
+
+		// -- Allocate heap memory, and bind images.
+
+		VmaAllocationInfo heapAllocationInfo{};
+
+		if ( !entries.empty() ) {
+
+			VkMemoryRequirements heapRequirements{ heap.size, heapAlignment, memoryTypeBits };
+
+			VmaAllocationCreateInfo allocationCreateInfo{};
+			allocationCreateInfo.usage          = VMA_MEMORY_USAGE_GPU_ONLY;
+			allocationCreateInfo.preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+			if ( VK_SUCCESS != vmaAllocateMemory( self->mAllocator, &heapRequirements, &allocationCreateInfo, &heap.allocation, &heapAllocationInfo ) ) {
+
+				std::cerr << "WARNING: Could not allocate " << std::dec << heap.size << " Bytes for transient images, allocating images individually." << std::endl
+				          << std::flush;
+
+				for ( size_t i = 0; i != entries.size(); i++ ) {
+					device.destroyImage( images[ i ] );
+					heap.unplaced.push_back( entries[ i ].resource_id );
+				}
+
+				heap.allocation = nullptr;
+				heap.size       = 0;
+				entries.clear();
+				images.clear();
+			}
+		}
+
+		uint64_t bytesUnaliased = 0;
+
+		for ( size_t i = 0; i != entries.size(); i++ ) {
+
+			auto const &entry = entries[ i ];
+
+			auto result = vmaBindImageMemory2( self->mAllocator, heap.allocation, entry.offset, images[ i ], nullptr );
+			assert( result == VK_SUCCESS );
+			(void)result;
+
+			AllocatedResourceVk allocatedResource{};
+			allocatedResource.info                  = entry.info;
+			allocatedResource.as.image              = images[ i ];
+			allocatedResource.allocation            = nullptr; // memory is owned by transient heap
+			allocatedResource.allocationInfo        = heapAllocationInfo;
+			allocatedResource.allocationInfo.offset = heapAllocationInfo.offset + entry.offset;
+			allocatedResource.allocationInfo.size   = entry.size;
+
+			// If this image was previously allocated individually, bin the previous version.
+			auto foundIt = backendResources.find( entry.resource_id );
+			if ( foundIt != backendResources.end() ) {
+				frame.binnedResources.try_emplace( entry.resource_id, foundIt->second );
+			}
+
+			backendResources.insert_or_assign( entry.resource_id, allocatedResource );
+
+			bytesUnaliased += entry.size;
+		}
+
+		heap.entries = std::move( entries );
+
+		if ( !heap.entries.empty() ) {
+			std::cout << "Transient images: " << std::dec << heap.entries.size() << " images placed into " << heap.size << " Bytes, "
+			          << bytesUnaliased - heap.size << " Bytes saved through aliasing (" << bytesUnaliased << " Bytes unaliased)" << std::endl
+			          << std::flush;
+
+			if ( PRINT_DEBUG_MESSAGES ) {
+				for ( auto const &e : heap.entries ) {
+					std::cout << "\t" << ( e.resource_id.debug_name[ 0 ] == char( 0xe2 ) ? "  " : "" ) << std::setw( 32 ) << e.resource_id.debug_name
+					          << " : offset " << std::setw( 11 ) << e.offset
+					          << " : " << std::setw( 11 ) << e.size << " Bytes"
+					          << " : passes " << std::setw( 3 ) << e.first_pass << ".." << e.last_pass
+					          << std::endl;
+				}
+				std::cout << std::flush;
+			}
+		}
+	}
+
+	// -- Images which share memory with any other image must start out undefined, and
+	// wait for earlier accesses to shared memory before their first use.
+
+	for ( auto const &e : heap.entries ) {
+		if ( !e.in_use ) {
+			continue;
+		}
+		for ( auto const &other : heap.entries ) {
+			if ( &e != &other && share_memory( e, other ) ) {
+				frame.aliasedResources.push_back( { e.resource_id, e.first_pass } );
+				break;
+			}
+		}
+	}
+}
+
 // ----------------------------------------------------------------------
 // Allocates all physical Vulkan memory resources (Images/Buffers) referenced to by the frame.
 //
@@ -3068,7 +4244,10 @@ static void backend_allocate_resources( le_backend_o *self, BackendFrameData &fr
 	// It's possible that this was more than two frames ago,
 	// depending on how many swapchain images there are.
 	//
-	frame_release_binned_resources( frame, self->device->getVkDevice(), self->mAllocator );
+	if ( !frame.binnedResources.empty() ) {
+		self->descriptorCacheEpoch++; // binned resources may be referred to by cached descriptor sets
+	}
+	frame_release_binned_resources( frame, self->device->getVkDevice(), self->mAllocator, &self->objectCache );
 
 	// Iterate over all resource declarations in all passes so that we can collect all resources,
 	// and their usage information. Later, we will consolidate their usages so that resources can
@@ -3100,6 +4279,14 @@ static void backend_allocate_resources( le_backend_o *self, BackendFrameData &fr
 	// resource info, so that multisample versions of image resources can be allocated dynamically.
 	insert_msaa_versions( usedResources, usedResourcesInfos );
 
+	if ( LE_BACKEND_ALIAS_TRANSIENT_IMAGES ) {
+		// Transient images with non-overlapping lifetimes may share memory - we place these
+		// into backend resources before the general case below, which will then find them.
+		std::vector<le_resource_lifetime_t> lifetimes;
+		collect_image_lifetimes( passes, numRenderPasses, lifetimes );
+		backend_alias_transient_images( self, frame, usedResources, usedResourcesInfos, lifetimes );
+	}
+
 	// Check if all resources declared in this frame are already available in backend.
 	// If a resource is not available yet, this resource must be allocated.
 
@@ -3302,7 +4489,7 @@ static void backend_allocate_resources( le_backend_o *self, BackendFrameData &fr
 
 // Allocates ImageViews, Samplers and Textures requested by individual passes
 // these are tied to the lifetime of the frame, and will be re-created
-static void frame_allocate_transient_resources( BackendFrameData &frame, vk::Device const &device, le_renderpass_o **passes, size_t numRenderPasses ) {
+static void frame_allocate_transient_resources( BackendFrameData &frame, vk::Device const &device, le_vk_object_cache_o *objectCache, le_renderpass_o **passes, size_t numRenderPasses ) {
 
 	using namespace le_renderer;
 
@@ -3369,17 +4556,9 @@ static void frame_allocate_transient_resources( BackendFrameData &frame, vk::Dev
 				    .setComponents( {} ) // default component mapping
 				    .setSubresourceRange( subresourceRange );
 
-				auto imageView = device.createImageView( imageViewCreateInfo );
-
 				// Store image view object with frame, indexed by image resource id,
 				// so that it can be found quickly if need be.
-				frame.imageViews[ r ] = imageView;
-
-				AbstractPhysicalResource imgView{};
-				imgView.type        = AbstractPhysicalResource::Type::eImageView;
-				imgView.asImageView = imageView;
-
-				frame.ownedResources.emplace_front( std::move( imgView ) );
+				frame.imageViews[ r ] = frame_acquire_image_view( frame, device, objectCache, imageViewCreateInfo );
 			}
 		}
 	}
@@ -3440,16 +4619,7 @@ static void frame_allocate_transient_resources( BackendFrameData &frame, vk::Dev
 					    .setComponents( {} )      // default component mapping
 					    .setSubresourceRange( subresourceRange );
 
-					imageView = device.createImageView( imageViewCreateInfo );
-
-					// Store vk object references with frame-owned resources, so that
-					// the vk objects can be destroyed when frame crosses the fence.
-
-					AbstractPhysicalResource res;
-					res.asImageView = imageView;
-					res.type        = AbstractPhysicalResource::Type::eImageView;
-
-					frame.ownedResources.emplace_front( std::move( res ) );
+					imageView = frame_acquire_image_view( frame, device, objectCache, imageViewCreateInfo );
 				}
 
 				vk::Sampler sampler{};
@@ -3475,16 +4645,23 @@ static void frame_allocate_transient_resources( BackendFrameData &frame, vk::Dev
 					    .setBorderColor( le_border_color_to_vk( texInfo.sampler.borderColor ) )
 					    .setUnnormalizedCoordinates( texInfo.sampler.unnormalizedCoordinates );
 
-					sampler = device.createSampler( samplerCreateInfo );
+					// Samplers don't refer to any images - everything from flags to the end of the
+					// create info struct goes into the key.
+
+					static_assert( sizeof( VkSamplerCreateInfo ) - offsetof( VkSamplerCreateInfo, flags ) == 16 * sizeof( uint32_t ),
+					               "SamplerCreateInfo must be tightly packed for hashing" );
 
-					// Now store vk object references with frame-owned resources, so that
-					// the vk objects can be destroyed when frame crosses the fence.
+					VkSamplerCreateInfo const &info = samplerCreateInfo;
 
-					AbstractPhysicalResource res;
+					size_t const sampler_key_num_bytes = sizeof( VkSamplerCreateInfo ) - offsetof( VkSamplerCreateInfo, flags );
 
-					res.asSampler = sampler;
-					res.type      = AbstractPhysicalResource::Type::eSampler;
-					frame.ownedResources.emplace_front( std::move( res ) );
+					sampler = object_cache_acquire( objectCache, frame, AbstractPhysicalResource::eSampler, &info.flags, sampler_key_num_bytes, nullptr, 0, [ & ]() {
+						          AbstractPhysicalResource res;
+						          res.type      = AbstractPhysicalResource::Type::eSampler;
+						          res.asSampler = device.createSampler( samplerCreateInfo );
+						          return res;
+					          } )
+					              .asSampler;
 				}
 
 				// -- Store Texture with frame so that decoder can find references
@@ -3566,10 +4743,23 @@ static bool backend_acquire_physical_resources( le_backend_o *              self
 		frame.syncChainTable.insert( { res.first, { res.second.state } } );
 	}
 
+	// Images which share memory with other transient images may have been overwritten since
+	// their last use - their contents, and therefore their layout, are undefined.
+	for ( auto const &r : frame.aliasedResources ) {
+		auto &initialState          = frame.syncChainTable.at( r.resource_id ).front();
+		initialState.visible_access = {};
+		initialState.write_stage    = vk::PipelineStageFlagBits::eBottomOfPipe; // forms a dependency chain with the aliasing barrier
+		initialState.layout         = vk::ImageLayout::eUndefined;
+	}
+
 	// -- build sync chain for each resource, create explicit sync barrier requests for resources
 	// which cannot be impliciltly synced.
 	frame_track_resource_state( frame, passes, numRenderPasses, LE_SWAPCHAIN_IMAGE_HANDLE );
 
+	for ( auto const &r : frame.aliasedResources ) {
+		frame.passes[ r.first_pass ].needsAliasingBarrier = true;
+	}
+
 	// At this point we know the state for each resource at the end of the sync chain.
 	// this state will be the initial state for the resource
 
@@ -3608,18 +4798,18 @@ static bool backend_acquire_physical_resources( le_backend_o *              self
 	vk::Device device = self->device->getVkDevice();
 
 	// -- allocate any transient vk objects such as image samplers, and image views
-	frame_allocate_transient_resources( frame, device, passes, numRenderPasses );
+	frame_allocate_transient_resources( frame, device, &self->objectCache, passes, numRenderPasses );
 
 	// create renderpasses - use sync chain to apply implicit syncing for image attachment resources
-	backend_create_renderpasses( frame, device );
+	backend_create_renderpasses( frame, device, &self->objectCache );
 
 	// -- make sure that there is a descriptorpool for every renderpass
-	backend_create_descriptor_pools( frame, device, numRenderPasses );
+	backend_create_descriptor_caches( frame, device, numRenderPasses );
 
 	// patch and retain physical resources in bulk here, so that
 	// each pass may be processed independently
 
-	backend_create_frame_buffers( frame, device );
+	backend_create_frame_buffers( frame, device, &self->objectCache );
 
 	return true;
 };
@@ -3640,18 +4830,8 @@ static le_allocator_o **backend_create_transient_allocators( le_backend_o *self,
 
 		assert( numAllocators < 256 ); // must not have more than 255 allocators, otherwise we cannot store index in LeResourceHandleMeta.
 
-		VkBuffer          buffer = nullptr;
-		VmaAllocation     allocation;
-		VmaAllocationInfo allocationInfo;
-
-		VmaAllocationCreateInfo createInfo{};
-		createInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
-		createInfo.pool  = frame.allocationPool; // Since we're allocating from a pool all fields but .flags will be taken from the pool
-
 		le_resource_handle_t res = declare_resource_virtual_buffer( uint8_t( i ) );
 
-		createInfo.pUserData = &res;
-
 		VkBufferCreateInfo bufferCreateInfo;
 		{
 			// we use the cpp proxy because it's more ergonomic to fill the values.
@@ -3666,17 +4846,12 @@ static le_allocator_o **backend_create_transient_allocators( le_backend_o *self,
 			bufferCreateInfo = bufferInfoProxy;
 		}
 
-		auto result = vmaCreateBuffer( self->mAllocator, &bufferCreateInfo, &createInfo, &buffer, &allocation, &allocationInfo );
-
-		assert( result == VK_SUCCESS ); // todo: deal with failed allocation
-
-		// Create a new allocator - note that we assume an alignment of 256 bytes
-		le_allocator_o *allocator = le_allocator_linear_i.create( &allocationInfo, 256 );
+		// Create a new allocator - note that we assume an alignment of 256 bytes.
+		// The allocator allocates its buffers from the frame pool, and will chain
+		// additional buffers of the same size should it run out of memory.
+		le_allocator_o *allocator = le_allocator_linear_i.create( self->mAllocator, frame.allocationPool, &bufferCreateInfo, &res, 256 );
 
 		frame.allocators.emplace_back( allocator );
-		frame.allocatorBuffers.emplace_back( std::move( buffer ) );
-		frame.allocations.emplace_back( std::move( allocation ) );
-		frame.allocationInfos.emplace_back( std::move( allocationInfo ) );
 	}
 
 	return frame.allocators.data();
@@ -3701,8 +4876,25 @@ static bool is_equal( le_pipeline_and_layout_info_t const &lhs, le_pipeline_and_
 	       0 == memcmp( lhs.layout_info.set_layout_keys, rhs.layout_info.set_layout_keys, sizeof( uint64_t ) * lhs.layout_info.set_layout_count );
 }
 
+// Commands which only make sense with the graphics pipeline which they were recorded
+// against - these must be skipped while this pipeline is not available.
+static bool command_depends_on_graphics_pipeline( le::CommandType const &type ) {
+	switch ( type ) {
+	case le::CommandType::eDraw:
+	case le::CommandType::eDrawIndexed:
+	case le::CommandType::eDrawMeshTasks:
+	case le::CommandType::eBindArgumentBuffer:
+	case le::CommandType::eSetArgumentTexture:
+	case le::CommandType::eSetArgumentImage:
+	case le::CommandType::eSetArgumentTlas:
+		return true;
+	default:
+		return false;
+	}
+}
+
 static bool updateArguments( const vk::Device &                 device,
-                             const vk::DescriptorPool &         descriptorPool_,
+                             le_descriptor_cache_o &            descriptorCache,
                              const ArgumentState &              argumentState,
                              std::array<DescriptorSetState, 8> &previousSetData,
                              vk::DescriptorSet *                descriptorSets ) {
@@ -3817,83 +5009,102 @@ static bool updateArguments( const vk::Device &                 device,
 			     previousSetData[ setId ].setData != argumentState.setData[ setId ] ||
 			     previousSetData[ setId ].setLayout != argumentState.layouts[ setId ] ) {
 
-				vk::DescriptorSetAllocateInfo allocateInfo;
-				allocateInfo.setDescriptorPool( descriptorPool_ )
-				    .setDescriptorSetCount( 1 )
-				    .setPSetLayouts( &argumentState.layouts[ setId ] );
+				auto const &setLayout = argumentState.layouts[ setId ];
+				auto const &setData   = argumentState.setData[ setId ];
 
-				// -- allocate descriptorSets based on current layout
-				// and place them in the correct position
-				auto result = device.allocateDescriptorSets( &allocateInfo, &descriptorSets[ setId ] );
+				// -- Look up a descriptor set with matching layout and data in the descriptor
+				// cache - we only allocate and write a new descriptor set if there is none.
 
-				assert( result == vk::Result::eSuccess && "failed to allocate descriptor set" );
+				uint64_t setHash = descriptor_set_hash( setLayout, setData );
+				auto &   entry   = descriptorCache.entries[ setHash ];
 
-				if ( /* DISABLES CODE */ ( false ) ) {
-					// I wish that this would work - but it appears that accelerator decriptors cannot be updated using templates.
-					device.updateDescriptorSetWithTemplate( descriptorSets[ setId ], argumentState.updateTemplates[ setId ], argumentState.setData[ setId ].data() );
+				if ( entry.descriptorSet && entry.setLayout == setLayout && entry.setData == setData ) {
+					descriptorSets[ setId ] = entry.descriptorSet;
+					descriptorCache.statsSetsReused++;
 				} else {
 
-					std::vector<vk::WriteDescriptorSet> write_descriptor_sets;
+					// -- allocate descriptorSets based on current layout
+					// and place them in the correct position
+					descriptorSets[ setId ] = descriptor_cache_allocate_set( descriptorCache, device, setLayout, setData );
 
-					// We deliberately allocate write descriptor set acceleration structure objects on the heap,
-					// so that the pointer to the object will not change if and when the vector grows.
-					//
-					// This means that we can hand out copies of pointers from this vector without fear from
-					// within the current scope, but also that we must clean up the contents of the vector
-					// manually before leaving the current scope or else we will leak these objects.
-					std::vector<vk::WriteDescriptorSetAccelerationStructureKHR *> write_acceleration_structures;
-
-					write_descriptor_sets.reserve( argumentState.setData[ setId ].size() );
-
-					for ( auto &a : argumentState.setData[ setId ] ) {
-						vk::WriteDescriptorSet w{};
-
-						w
-						    .setDstSet( descriptorSets[ setId ] )
-						    .setDstBinding( a.bindingNumber )
-						    .setDstArrayElement( a.arrayIndex )
-						    .setDescriptorCount( 1 )
-						    .setDescriptorType( a.type ) //
-						    ;
-
-						switch ( a.type ) {
-						case vk::DescriptorType::eSampler:
-						case vk::DescriptorType::eCombinedImageSampler:
-						case vk::DescriptorType::eSampledImage:
-						case vk::DescriptorType::eStorageImage:
-						case vk::DescriptorType::eInputAttachment:
-							w.setPImageInfo( reinterpret_cast<vk::DescriptorImageInfo const *>( &a.imageInfo ) );
-							break;
-						case vk::DescriptorType::eUniformTexelBuffer:
-						case vk::DescriptorType::eStorageTexelBuffer:
-							w.setPTexelBufferView( reinterpret_cast<vk::BufferView const *>( &a.texelBufferInfo ) );
-							break;
-						case vk::DescriptorType::eUniformBuffer:
-						case vk::DescriptorType::eStorageBuffer:
-						case vk::DescriptorType::eUniformBufferDynamic:
-						case vk::DescriptorType::eStorageBufferDynamic:
-							w.setPBufferInfo( reinterpret_cast<vk::DescriptorBufferInfo const *>( &a.bufferInfo ) );
-							break;
-						case vk::DescriptorType::eInlineUniformBlockEXT:
-							assert( false && "inline uniform blocks are not yet supported" );
-							break;
-						case vk::DescriptorType::eAccelerationStructureKHR:
-							auto wd                        = new vk::WriteDescriptorSetAccelerationStructureKHR{};
-							wd->accelerationStructureCount = 1;
-							wd->pAccelerationStructures    = &a.accelerationStructureInfo.accelerationStructure;
-							w.setPNext( wd );
-							break;
+					if ( /* DISABLES CODE */ ( false ) ) {
+						// I wish that this would work - but it appears that accelerator decriptors cannot be updated using templates.
+						device.updateDescriptorSetWithTemplate( descriptorSets[ setId ], argumentState.updateTemplates[ setId ], argumentState.setData[ setId ].data() );
+					} else {
+
+						std::vector<vk::WriteDescriptorSet> write_descriptor_sets;
+
+						// We deliberately allocate write descriptor set acceleration structure objects on the heap,
+						// so that the pointer to the object will not change if and when the vector grows.
+						//
+						// This means that we can hand out copies of pointers from this vector without fear from
+						// within the current scope, but also that we must clean up the contents of the vector
+						// manually before leaving the current scope or else we will leak these objects.
+						std::vector<vk::WriteDescriptorSetAccelerationStructureKHR *> write_acceleration_structures;
+
+						write_descriptor_sets.reserve( argumentState.setData[ setId ].size() );
+
+						for ( auto &a : argumentState.setData[ setId ] ) {
+							vk::WriteDescriptorSet w{};
+
+							w
+							    .setDstSet( descriptorSets[ setId ] )
+							    .setDstBinding( a.bindingNumber )
+							    .setDstArrayElement( a.arrayIndex )
+							    .setDescriptorCount( 1 )
+							    .setDescriptorType( a.type ) //
+							    ;
+
+							switch ( a.type ) {
+							case vk::DescriptorType::eSampler:
+							case vk::DescriptorType::eCombinedImageSampler:
+							case vk::DescriptorType::eSampledImage:
+							case vk::DescriptorType::eStorageImage:
+							case vk::DescriptorType::eInputAttachment:
+								w.setPImageInfo( reinterpret_cast<vk::DescriptorImageInfo const *>( &a.imageInfo ) );
+								break;
+							case vk::DescriptorType::eUniformTexelBuffer:
+							case vk::DescriptorType::eStorageTexelBuffer:
+								w.setPTexelBufferView( reinterpret_cast<vk::BufferView const *>( &a.texelBufferInfo ) );
+								break;
+							case vk::DescriptorType::eUniformBuffer:
+							case vk::DescriptorType::eStorageBuffer:
+							case vk::DescriptorType::eUniformBufferDynamic:
+							case vk::DescriptorType::eStorageBufferDynamic:
+								w.setPBufferInfo( reinterpret_cast<vk::DescriptorBufferInfo const *>( &a.bufferInfo ) );
+								break;
+							case vk::DescriptorType::eInlineUniformBlockEXT:
+								assert( false && "inline uniform blocks are not yet supported" );
+								break;
+							case vk::DescriptorType::eAccelerationStructureKHR:
+								auto wd                        = new vk::WriteDescriptorSetAccelerationStructureKHR{};
+								wd->accelerationStructureCount = 1;
+								wd->pAccelerationStructures    = &a.accelerationStructureInfo.accelerationStructure;
+								w.setPNext( wd );
+								write_acceleration_structures.push_back( wd );
+								break;
+							}
+
+							write_descriptor_sets.emplace_back( w );
 						}
+						device.updateDescriptorSets( uint32_t( write_descriptor_sets.size() ), write_descriptor_sets.data(), 0, nullptr );
 
-						write_descriptor_sets.emplace_back( w );
+						// We must manually delete any WriteDescriptorSetAccelerationStructureKHR objects
+						for ( auto &w : write_acceleration_structures ) {
+							delete ( w );
+						}
 					}
-					device.updateDescriptorSets( uint32_t( write_descriptor_sets.size() ), write_descriptor_sets.data(), 0, nullptr );
 
-					// We must manually delete any WriteDescriptorSetAccelerationStructureKHR objects
-					for ( auto &w : write_acceleration_structures ) {
-						delete ( w );
-					}
+					entry.descriptorSet = descriptorSets[ setId ];
+					entry.setLayout     = setLayout;
+					entry.setData       = setData;
+				}
+
+				if ( entry.lastUsedFrame != descriptorCache.frameNumber ) {
+					entry.lastUsedFrame = descriptorCache.frameNumber;
+					descriptorCache.entriesUsed++;
 				}
+
 				previousSetData[ setId ].setData   = argumentState.setData[ setId ];
 				previousSetData[ setId ].setLayout = argumentState.layouts[ setId ];
 			}
@@ -3933,6 +5144,7 @@ static void debug_print_command( void *&cmd ) {
                 case (le::CommandType::eBuildRtxTlas): std::cout << "eBuildRtxTlas"; break;
                 case (le::CommandType::eBuildRtxBlas): std::cout << "eBuildRtxBlas"; break;
 			    case (le::CommandType::eWriteToImage): std::cout << "eWriteToImage"; break;
+			    case (le::CommandType::eJump): std::cout << "eJump"; break;
 			}
 	// clang-format on
 
@@ -3946,20 +5158,19 @@ static void debug_print_command( void *&cmd ) {
 };
 
 // ----------------------------------------------------------------------
-// Decode commandStream for each pass (may happen in parallel)
-// translate into vk specific commands.
-static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
-
-	if ( PRINT_DEBUG_MESSAGES ) {
-		std::cout << "** Process Frame #" << std::dec << std::setw( 8 ) << frameIndex << " **" << std::endl
-		          << std::flush;
-	}
+// Decode commandStream for a single pass, and translate into vk specific
+// commands, which get recorded into a new primary command buffer.
+//
+// Passes may be processed in parallel: each pass allocates its command buffer
+// from the command pool of the execution context (worker thread) it runs on,
+// and allocates descriptor sets from its own descriptor pool. Frame data is
+// only read here, with the exception of the pass's own slot in
+// frame.commandBuffers, and frame.commandBufferPoolIndices.
+static void backend_process_pass( le_backend_o *self, BackendFrameData &frame, size_t passIndex ) {
 
 	using namespace le_renderer;   // for encoder
 	using namespace le_backend_vk; // for device
 
-	auto &frame = self->mFrames[ frameIndex ];
-
 	vk::Device device = self->device->getVkDevice();
 
 	static_assert( sizeof( vk::Viewport ) == sizeof( le::Viewport ), "Viewport data size must be same in vk and le" );
@@ -3967,21 +5178,36 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 
 	static auto maxVertexInputBindings = vk_device_i.get_vk_physical_device_properties( *self->device ).limits.maxVertexInputBindings;
 
-	// TODO: (parallelize) when going wide, there needs to be a commandPool for each execution context so that
-	// command buffer generation may be free-threaded.
-	auto numCommandBuffers = uint32_t( frame.passes.size() );
-	auto cmdBufs           = device.allocateCommandBuffers( { frame.commandPool, vk::CommandBufferLevel::ePrimary, numCommandBuffers } );
+#if ( LE_MT > 0 )
+	// Threads outside the job system must not share a pool with any worker:
+	// they use the last pool, which is reserved for them.
+	const int32_t worker_id = le_jobs::get_current_worker_id();
+	const auto    poolIndex = worker_id < 0 ? uint32_t( frame.commandPools.size() - 1 ) : uint32_t( worker_id );
+	assert( ( worker_id < 0 || poolIndex + 1 < frame.commandPools.size() ) && "not enough command pools for worker threads" );
+#else
+	const uint32_t poolIndex = 0;
+#endif
 
-	std::array<vk::ClearValue, 16> clearValues{};
+	assert( poolIndex < frame.commandPools.size() && "not enough command pools for execution contexts" );
 
-	// TODO: (parallel for)
-	// note that access to any caches when creating pipelines and layouts and descriptorsets must be
-	// mutex-controlled when processing happens concurrently.
-	for ( size_t passIndex = 0; passIndex != frame.passes.size(); ++passIndex ) {
+	// Command pools are externally synchronised - only the current worker
+	// thread may allocate from, or record into buffers from, this pool.
+	vk::CommandBuffer cmd;
+	{
+		vk::CommandBufferAllocateInfo info{ frame.commandPools[ poolIndex ], vk::CommandBufferLevel::ePrimary, 1 };
+		device.allocateCommandBuffers( &info, &cmd );
+	}
+
+	frame.commandBuffers[ passIndex ]           = cmd;
+	frame.commandBufferPoolIndices[ passIndex ] = poolIndex;
+
+	std::array<vk::ClearValue, 16> clearValues{};
 
+	{
 		auto &pass           = frame.passes[ passIndex ];
-		auto &cmd            = cmdBufs[ passIndex ];
-		auto &descriptorPool = frame.descriptorPools[ passIndex ];
+		auto &descriptorCache = frame.descriptorCaches[ passIndex ];
+
+		descriptor_cache_begin_frame( descriptorCache, device, self->descriptorCacheEpoch );
 
 		// create frame buffer, based on swapchain and renderpass
 
@@ -3994,6 +5220,20 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 				          << std::flush;
 			}
 
+			if ( pass.needsAliasingBarrier ) {
+				// Images first used in this pass share memory with images used earlier, in this
+				// or in a previous frame. Any earlier accesses to this memory must complete, and
+				// writes be made available, before these images may take over the memory.
+				vk::MemoryBarrier aliasingBarrier{ vk::AccessFlagBits::eMemoryWrite, vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite };
+
+				cmd.pipelineBarrier( vk::PipelineStageFlagBits::eAllCommands, // srcStage
+				                     vk::PipelineStageFlagBits::eAllCommands, // dstStage
+				                     {},
+				                     { aliasingBarrier },
+				                     {},
+				                     {} );
+			}
+
 			// -- Issue sync barriers for all resources which require explicit sync.
 			//
 			// We must to this here, as the spec requires barriers to happen
@@ -4008,7 +5248,7 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 
 				// ---------| invariant: barrier is active.
 
-				auto const &syncChain = frame.syncChainTable[ op.resource_id ];
+				auto const &syncChain = frame.syncChainTable.at( op.resource_id );
 
 				auto const &stateInitial = syncChain[ op.sync_chain_offset_initial ];
 				auto const &stateFinal   = syncChain[ op.sync_chain_offset_final ];
@@ -4136,6 +5376,17 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 
 		if ( pass.encoder ) {
 			encoder_i.get_encoded_data( pass.encoder, &commandStream, &dataSize, &numCommands );
+
+			size_t numCommandsElided = encoder_i.get_elided_commands_count( pass.encoder );
+
+			if ( PRINT_DEBUG_MESSAGES && numCommandsElided ) {
+				std::cout << "Pass '" << pass.debugName << "': " << std::dec << numCommands << " commands, "
+				          << numCommandsElided << " redundant commands elided" << std::endl
+				          << std::flush;
+			}
+
+			self->commandsRecorded += numCommands;
+			self->commandsElided += numCommandsElided;
 		} else {
 
 			// This is legit behaviour for draw passes which are used only to clear attachments,
@@ -4153,16 +5404,30 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 			std::vector<vk::Buffer>       vertexInputBindings( maxVertexInputBindings, nullptr );
 			void *                        dataIt = commandStream;
 			le_pipeline_and_layout_info_t currentPipeline{};
+			bool                          isGraphicsPipelinePending = false; // whether requested graphics pipeline is still being created
 
 			while ( commandIndex != numCommands ) {
 
 				auto header = static_cast<le::CommandHeader *>( dataIt );
 
+				if ( header->info.type == le::CommandType::eJump ) {
+					// Command stream continues in another chunk - jumps don't count as commands.
+					dataIt = static_cast<le::CommandJump *>( dataIt )->info.next;
+					continue;
+				}
+
 				if ( /* DISABLES CODE */ ( false ) ) {
 					// Print the command stream to stdout.
 					debug_print_command( dataIt );
 				}
 
+				if ( isGraphicsPipelinePending && command_depends_on_graphics_pipeline( header->info.type ) ) {
+					// Skip draws, and arguments for draws, until a pipeline which is available gets bound.
+					dataIt = static_cast<char *>( dataIt ) + header->info.size;
+					++commandIndex;
+					continue;
+				}
+
 				switch ( header->info.type ) {
 
 				case le::CommandType::eBindGraphicsPipeline: {
@@ -4175,6 +5440,16 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 						// -- potentially compile and create pipeline here, based on current pass and subpass
 						auto requestedPipeline = le_pipeline_manager_i.produce_graphics_pipeline( pipelineManager, le_cmd->info.gpsoHandle, pass, subpassIndex );
 
+						// Pipeline may still be being created in the background, with no fallback pipeline
+						// to stand in for it. Reset current pipeline, so that argument state gets rebuilt
+						// once a pipeline becomes available.
+						isGraphicsPipelinePending = ( nullptr == requestedPipeline.pipeline );
+
+						if ( isGraphicsPipelinePending ) {
+							currentPipeline = {};
+							break;
+						}
+
 						if ( /* DISABLES CODE */ ( false ) ) {
 
 							// Print pipeline debug info when a new pipeline gets bound.
@@ -4471,7 +5746,7 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 					auto *le_cmd = static_cast<le::CommandTraceRays *>( dataIt );
 
 					// -- update descriptorsets via template if tainted
-					bool argumentsOk = updateArguments( device, descriptorPool, argumentState, previousSetState, descriptorSets );
+					bool argumentsOk = updateArguments( device, descriptorCache, argumentState, previousSetState, descriptorSets );
 
 					if ( false == argumentsOk ) {
 						break;
@@ -4521,7 +5796,7 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 					auto *le_cmd = static_cast<le::CommandDispatch *>( dataIt );
 
 					// -- update descriptorsets via template if tainted
-					bool argumentsOk = updateArguments( device, descriptorPool, argumentState, previousSetState, descriptorSets );
+					bool argumentsOk = updateArguments( device, descriptorCache, argumentState, previousSetState, descriptorSets );
 
 					if ( false == argumentsOk ) {
 						break;
@@ -4547,7 +5822,7 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 					auto *le_cmd = static_cast<le::CommandDraw *>( dataIt );
 
 					// -- update descriptorsets via template if tainted
-					bool argumentsOk = updateArguments( device, descriptorPool, argumentState, previousSetState, descriptorSets );
+					bool argumentsOk = updateArguments( device, descriptorCache, argumentState, previousSetState, descriptorSets );
 
 					if ( false == argumentsOk ) {
 						break;
@@ -4573,7 +5848,7 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 					auto *le_cmd = static_cast<le::CommandDrawIndexed *>( dataIt );
 
 					// -- update descriptorsets via template if tainted
-					bool argumentsOk = updateArguments( device, descriptorPool, argumentState, previousSetState, descriptorSets );
+					bool argumentsOk = updateArguments( device, descriptorCache, argumentState, previousSetState, descriptorSets );
 
 					if ( false == argumentsOk ) {
 						break;
@@ -4599,7 +5874,7 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 					auto *le_cmd = static_cast<le::CommandDrawMeshTasks *>( dataIt );
 
 					// -- update descriptorsets via template if tainted
-					bool argumentsOk = updateArguments( device, descriptorPool, argumentState, previousSetState, descriptorSets );
+					bool argumentsOk = updateArguments( device, descriptorCache, argumentState, previousSetState, descriptorSets );
 
 					if ( false == argumentsOk ) {
 						break;
@@ -4661,7 +5936,7 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 					if ( b == argumentState.binding_infos.end() ) {
 						static uint64_t wrong_argument = argument_name_id;
 						[]( uint64_t argument ) {
-							static uint64_t argument_id_local = 0;
+							static thread_local uint64_t argument_id_local = 0;
 							if ( argument_id_local == wrong_argument )
 								return;
 							std::cout << "backend_process_frame:"
@@ -4878,7 +6153,9 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 					// TODO: we must sync this before the next read.
 					auto *le_cmd = static_cast<le::CommandWriteToBuffer *>( dataIt );
 
-					vk::BufferCopy region( le_cmd->info.src_offset, le_cmd->info.dst_offset, le_cmd->info.numBytes );
+					uint64_t const srcOffset = frame_data_get_buffer_offset_from_le_resource_id( frame, le_cmd->info.src_buffer_id ) + le_cmd->info.src_offset;
+
+					vk::BufferCopy region( srcOffset, le_cmd->info.dst_offset, le_cmd->info.numBytes );
 
 					auto srcBuffer = frame_data_get_buffer_from_le_resource_id( frame, le_cmd->info.src_buffer_id );
 					auto dstBuffer = frame_data_get_buffer_from_le_resource_id( frame, le_cmd->info.dst_buffer_id );
@@ -4896,8 +6173,11 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 					auto *le_cmd = static_cast<le::CommandWriteToImage *>( dataIt );
 
 					auto srcBuffer = frame_data_get_buffer_from_le_resource_id( frame, le_cmd->info.src_buffer_id );
+					auto srcOffset = frame_data_get_buffer_offset_from_le_resource_id( frame, le_cmd->info.src_buffer_id );
 					auto dstImage  = frame_data_get_image_from_le_resource_id( frame, le_cmd->info.dst_image_id );
 
+					assert( srcOffset % LE_STAGING_ALIGNMENT == 0 && "staging offset must satisfy buffer-image copy alignment" );
+
 					// We define a range that covers all miplevels. this is useful as it allows us to transform
 					// Image layouts in bulk, covering the full mip chain.
 					vk::ImageSubresourceRange rangeAllRemainingMiplevels;
@@ -4916,7 +6196,7 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 						    .setSrcQueueFamilyIndex( VK_QUEUE_FAMILY_IGNORED )
 						    .setDstQueueFamilyIndex( VK_QUEUE_FAMILY_IGNORED )
 						    .setBuffer( srcBuffer )
-						    .setOffset( 0 ) // we assume a fresh buffer was allocated, so offset must be 0
+						    .setOffset( srcOffset ) // staging memory may be sub-allocated from a larger buffer
 						    .setSize( le_cmd->info.numBytes );
 
 						vk::ImageMemoryBarrier imageLayoutToTransferDstOptimal;
@@ -4957,7 +6237,7 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 
 						vk::BufferImageCopy region;
 						region
-						    .setBufferOffset( 0 )                                       // buffer offset is 0, since staging buffer is a fresh, specially allocated buffer
+						    .setBufferOffset( srcOffset )                               // staging memory may be sub-allocated from a larger buffer
 						    .setBufferRowLength( 0 )                                    // 0 means tightly packed
 						    .setBufferImageHeight( 0 )                                  // 0 means tightly packed
 						    .setImageSubresource( std::move( imageSubresourceLayers ) ) // stored inline
@@ -5311,12 +6591,49 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 		}
 
 		cmd.end();
+
+		self->descriptorSetsAllocated += descriptorCache.statsSetsAllocated;
+		self->descriptorSetsReused += descriptorCache.statsSetsReused;
+	}
+}
+
+// ----------------------------------------------------------------------
+// Decode commandStream for each pass (may happen in parallel)
+// translate into vk specific commands.
+static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
+
+	if ( PRINT_DEBUG_MESSAGES ) {
+		std::cout << "** Process Frame #" << std::dec << std::setw( 8 ) << frameIndex << " **" << std::endl
+		          << std::flush;
 	}
 
-	// place command buffer in frame store so that it can be submitted.
-	for ( auto &&c : cmdBufs ) {
-		frame.commandBuffers.emplace_back( c );
+	auto &frame = self->mFrames[ frameIndex ];
+
+	// Each pass fills in its own slot - command buffers are submitted in pass order.
+	frame.commandBuffers.resize( frame.passes.size(), nullptr );
+	frame.commandBufferPoolIndices.resize( frame.passes.size(), 0 );
+
+#if ( LE_MT > 0 )
+	// We're running inside a job: translate each pass as a job of its own.
+	// parallel_for only returns once all passes have been translated.
+	struct process_pass_params_t {
+		le_backend_o *    backend;
+		BackendFrameData *frame;
+	} params{ self, &frame };
+
+	le_jobs::parallel_for(
+	    0, uint32_t( frame.passes.size() ), 1, []( uint32_t begin, uint32_t end, void *user_data ) {
+		    auto p = static_cast<process_pass_params_t *>( user_data );
+		    for ( uint32_t i = begin; i != end; ++i ) {
+			    backend_process_pass( p->backend, *p->frame, i );
+		    }
+	    },
+	    &params );
+#else
+	for ( size_t passIndex = 0; passIndex != frame.passes.size(); ++passIndex ) {
+		backend_process_pass( self, frame, passIndex );
 	}
+#endif
 }
 
 // ----------------------------------------------------------------------
@@ -5331,6 +6648,12 @@ static le_shader_module_o *backend_create_shader_module( le_backend_o *self, cha
 	return le_pipeline_manager_i.create_shader_module( self->pipelineCache, path, moduleType, macro_definitions );
 }
 
+// ----------------------------------------------------------------------
+static void backend_create_shader_modules( le_backend_o *self, uint32_t num_modules, char const *const *paths, LeShaderStageEnum const *moduleTypes, char const *const *macro_definitions, le_shader_module_o **modules ) {
+	using namespace le_backend_vk;
+	le_pipeline_manager_i.create_shader_modules( self->pipelineCache, num_modules, paths, moduleTypes, macro_definitions, modules );
+}
+
 // ----------------------------------------------------------------------
 
 static le_pipeline_manager_o *backend_get_pipeline_cache( le_backend_o *self ) {
@@ -5434,6 +6757,7 @@ LE_MODULE_REGISTER_IMPL( le_backend_vk, api_ ) {
 	vk_backend_i.get_pipeline_cache    = backend_get_pipeline_cache;
 	vk_backend_i.update_shader_modules = backend_update_shader_modules;
 	vk_backend_i.create_shader_module  = backend_create_shader_module;
+	vk_backend_i.create_shader_modules = backend_create_shader_modules;
 
 	vk_backend_i.get_swapchain_resource = backend_get_swapchain_resource;
 	vk_backend_i.get_swapchain_extent   = backend_get_swapchain_extent;
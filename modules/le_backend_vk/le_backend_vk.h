@@ -50,6 +50,7 @@ struct VkMemoryAllocateInfo;
 struct LeRenderPass;
 
 struct VmaAllocator_T;
+struct VmaPool_T;
 struct VmaAllocation_T;
 struct VmaAllocationCreateInfo;
 struct VmaAllocationInfo;
@@ -82,6 +83,23 @@ struct le_pipeline_and_layout_info_t {
 	le_pipeline_layout_info layout_info;
 };
 
+struct le_pipeline_manager_stats_t {
+	uint64_t pipelines_pending;   // graphics pipelines which are currently being created in the background
+	uint64_t pipelines_compiled;  // pipelines created so far
+	uint64_t pipelines_stalled;   // pipelines created synchronously, on the calling thread - includes fallback pipelines, and all pipelines if LE_MT == 0
+	uint64_t pipelines_requested; // distinct pipelines handed over for creation in the background - repeat requests for a pending pipeline are not counted
+};
+
+struct le_allocator_linear_stats_t {
+	uint64_t bytes_used;             // bytes used since last reset, including unused space at the end of exhausted blocks
+	uint64_t bytes_used_last_frame;  // bytes used between the previous two resets
+	uint64_t high_water_mark;        // bytes used during the most demanding recent frame - blocks to cover this are kept on reset
+	uint64_t capacity;               // bytes held over all blocks currently owned by the allocator
+	uint32_t block_count;            // blocks currently owned by the allocator
+	uint32_t blocks_used_last_frame; // blocks used between the previous two resets
+	uint32_t blocks_added;           // blocks which had to be allocated since last reset
+};
+
 struct le_backend_vk_api {
 
 	// clang-format off
@@ -103,6 +121,7 @@ struct le_backend_vk_api {
 		le_staging_allocator_o*( *get_staging_allocator      ) ( le_backend_o* self, size_t frameIndex);
 
 		le_shader_module_o*    ( *create_shader_module       ) ( le_backend_o* self, char const * path, const LeShaderStageEnum& moduleType, char const * macro_definitions);
+		void                   ( *create_shader_modules      ) ( le_backend_o* self, uint32_t num_modules, char const * const * paths, LeShaderStageEnum const * moduleTypes, char const * const * macro_definitions, le_shader_module_o** modules);
 		void                   ( *update_shader_modules      ) ( le_backend_o* self );
 
 		le_pipeline_manager_o* ( *get_pipeline_cache         ) ( le_backend_o* self);
@@ -190,7 +209,15 @@ struct le_backend_vk_api {
 		le_pipeline_and_layout_info_t            ( *produce_rtx_pipeline              ) ( le_pipeline_manager_o *self, le_rtxpso_handle rtxpsoHandle, char ** shader_group_data);
 		le_pipeline_and_layout_info_t            ( *produce_compute_pipeline          ) ( le_pipeline_manager_o *self, le_cpso_handle cpsoHandle);
 
+		// With LE_MT > 0, graphics pipelines are created in the background: until a pipeline is ready, produce_graphics_pipeline
+		// returns the pipeline for the fallback pso set here, or, if no fallback was set, a nullptr pipeline.
+		bool                                     ( *set_graphics_pipeline_fallback    ) ( le_pipeline_manager_o *self, le_gpso_handle gpsoHandle, le_gpso_handle fallbackGpsoHandle);
+		void                                     ( *get_stats                         ) ( le_pipeline_manager_o *self, le_pipeline_manager_stats_t* stats);
+
 		le_shader_module_o*                      ( *create_shader_module              ) ( le_pipeline_manager_o* self, char const * path, const LeShaderStageEnum& moduleType, char const *macro_definitions);
+
+		// Compiles shader modules concurrently (if LE_MT > 0). `macro_definitions` may be nullptr. Each element in `modules` receives a module, or nullptr on failure.
+		void                                     ( *create_shader_modules             ) ( le_pipeline_manager_o* self, uint32_t num_modules, char const * const * paths, LeShaderStageEnum const * moduleTypes, char const * const * macro_definitions, le_shader_module_o** modules);
 		void                                     ( *update_shader_modules             ) ( le_pipeline_manager_o* self );
 
 		struct VkPipelineLayout_T*               ( *get_pipeline_layout               ) ( le_pipeline_manager_o* self, uint64_t pipeline_layout_key);
@@ -198,11 +225,15 @@ struct le_backend_vk_api {
 	};
 
 	struct allocator_linear_interface_t {
-		le_allocator_o *        ( *create               ) ( VmaAllocationInfo const *info, uint16_t alignment);
+		// Blocks of `buffer_info->size` bytes get allocated from `pool` - the first block up-front, any further blocks on demand.
+		le_allocator_o *        ( *create               ) ( VmaAllocator_T* vmaAllocator, VmaPool_T* pool, VkBufferCreateInfo const * buffer_info, le_resource_handle_t const * resource_id, uint16_t alignment);
 		void                    ( *destroy              ) ( le_allocator_o* self );
 		bool                    ( *allocate             ) ( le_allocator_o* self, uint64_t numBytes, void ** pData, uint64_t* bufferOffset);
 		void                    ( *reset                ) ( le_allocator_o* self );
+		// Returns handle for the buffer which holds the most recent allocation - call this after each call to `allocate`.
 		le_resource_handle_t    ( *get_le_resource_id   ) ( le_allocator_o* self );
+		struct VkBuffer_T*      ( *get_block_buffer     ) ( le_allocator_o* self, uint16_t resource_index );
+		void                    ( *get_stats            ) ( le_allocator_o* self, le_allocator_linear_stats_t* stats );
 	};
 
 	struct staging_allocator_interface_t {
@@ -9,14 +9,26 @@
 
 #include <filesystem> // for parsing shader source file paths
 #include <fstream>    // for reading shader source files
+#include <sstream>
 #include <cstring>    // for memcpy
 #include <shared_mutex>
+#include <mutex>
+#include <atomic>
+#include <chrono>
 
 #include "le_shader_compiler/le_shader_compiler.h"
 #include "util/spirv-cross/spirv_cross.hpp"
 #include "le_file_watcher/le_file_watcher.h" // for watching shader source files
 #include "3rdparty/src/spooky/SpookyV2.h"    // for hashing renderpass gestalt, so that we can test for *compatible* renderpasses
 
+#ifndef LE_MT
+#	define LE_MT 0
+#endif
+
+#if ( LE_MT > 0 )
+#	include "le_jobs/le_jobs.h" // for compiling shader modules concurrently
+#endif
+
 struct le_shader_module_o {
 	uint64_t                                         hash                = 0;     ///< hash taken from spirv code + hash_file_path + hash_shader_defines
 	uint64_t                                         hash_file_path      = 0;     ///< hash taken from filepath (canonical)
@@ -33,15 +45,54 @@ struct le_shader_module_o {
 	le::ShaderStage                                  stage  = {};
 };
 
+struct le_shader_compile_batch_o;
+
 struct le_shader_manager_o {
 	vk::Device device = nullptr;
 
 	std::vector<le_shader_module_o *>                               shaderModules;         // OWNING. Stores all shader modules used in backend.
 	std::unordered_map<std::string, std::set<le_shader_module_o *>> moduleDependencies;    // map 'canonical shader source file path' -> [shader modules]
 	std::set<le_shader_module_o *>                                  modifiedShaderModules; // non-owning pointers to shader modules which need recompiling (used by file watcher)
+	std::shared_mutex                                               modulesMtx;            // held shared while modules are used to create pipelines, held exclusively while modules are updated
 
-	le_shader_compiler_o *shader_compiler   = nullptr; // owning
-	le_file_watcher_o *   shaderFileWatcher = nullptr; // owning
+	std::vector<le_shader_compiler_o *> shaderCompilers;          // owning - pool of compilers, so that modules may be compiled concurrently
+	std::vector<le_shader_compiler_o *> shaderCompilersAvailable; // non-owning - compilers from pool which are not currently in use
+	std::mutex                          shaderCompilersMtx;       // protects shaderCompilers, shaderCompilersAvailable
+
+	le_shader_compile_batch_o *pendingRecompile = nullptr; // owning - hot-reload recompilation in flight, nullptr if none
+
+	le_file_watcher_o *shaderFileWatcher = nullptr; // owning
+};
+
+// Source for a shader module which is to be translated to spir-v.
+//
+// Items may be processed concurrently - each item takes a compiler from the
+// shader manager's pool of compilers for as long as it is being processed.
+struct le_shader_compile_item_t {
+	le_shader_module_o *  module = nullptr; // non-owning - module which receives the result, nullptr if module is yet to be created
+	std::string           filepath;         // canonical path to source file
+	LeShaderStageEnum     stage{};          //
+	std::string           macro_defines;    // #defines to pass to shader compiler
+	bool                  loaded = false;   // result: whether source file could be loaded
+	std::vector<uint32_t> spirv;            // result: spir-v code, empty if compilation failed
+	std::set<std::string> includes;         // result: source files which module depends on, first element is `filepath`
+};
+
+// A batch of shader modules which are recompiled in the background, as le_jobs
+// jobs of background priority, while the previous version of each module stays
+// in use. Results are applied once all items of the batch have been compiled.
+struct le_shader_compile_batch_o {
+	le_shader_manager_o *                 shader_manager = nullptr;
+	std::vector<le_shader_compile_item_t> items;
+	std::atomic<uint32_t>                 num_items_pending{ 0 }; // job counters can't be polled, so we keep our own tally
+#if ( LE_MT > 0 )
+	struct job_params_t {
+		le_shader_compile_batch_o *batch;
+		le_shader_compile_item_t * item;
+	};
+	std::vector<job_params_t> job_params; // one per item, must outlive jobs
+	le_jobs::counter_t *      counter = nullptr;
+#endif
 };
 
 // A table from `handle` -> `object*`, protected by mutex.
@@ -193,18 +244,46 @@ class HashMap : NoCopy, NoMove {
 
 // NOTE: It might make sense to have one pipeline manager per worker thread, and
 //       to consolidate after the frame has been processed.
+#if ( LE_MT > 0 )
+// A graphics pipeline which is being created in the background, as an le_jobs job.
+struct le_pending_graphics_pipeline_t {
+	le_pipeline_manager_o *          pipeline_manager = nullptr;
+	graphics_pipeline_state_o const *pso              = nullptr; // non-owning, psos live for as long as the pipeline manager
+	LeRenderPass                     pass{};                     // copy of the renderpass fields which pipeline creation depends upon
+	uint32_t                         subpass       = 0;
+	uint64_t                         pipeline_hash = 0;
+	std::atomic<bool>                is_complete{ false }; // set by job once pipeline has been stored - job counters can't be polled
+	le_jobs::counter_t *             counter = nullptr;
+};
+#endif
+
 struct le_pipeline_manager_o {
 	le_device_o *le_device = nullptr; // arc-owning, increases reference count, decreases on destruction
 	vk::Device   device    = nullptr;
 
 	vk::PipelineCache vulkanCache = nullptr;
 
+	std::filesystem::path                 vulkanCacheFilePath;                     // pipeline cache gets loaded from, and saved to this file - empty if not available
+	std::chrono::steady_clock::time_point vulkanCacheLastSaveTime;                 // last time pipeline cache was saved to disk
+	uint64_t                              vulkanCachePipelinesCountAtLastSave = 0; // value of pipelinesCreatedCount at the time of last save
+	std::atomic<uint64_t>                 pipelinesCreatedCount{ 0 };              // number of vk pipelines created via this pipeline manager
+	std::atomic<uint64_t>                 pipelinesCreatedTimeNanoseconds{ 0 };    // total time spent creating vk pipelines - compare cold vs. warm pipeline cache
+	std::atomic<uint64_t>                 pipelinesStalledCount{ 0 };              // number of pipelines which had to be created synchronously, stalling the caller
+	std::atomic<uint64_t>                 pipelinesRequestedCount{ 0 };            // number of distinct pipelines handed over for creation in the background
+
+#if ( LE_MT > 0 )
+	std::mutex                                                                   pendingPipelinesMtx; // protects pendingPipelines
+	std::unordered_map<uint64_t, le_pending_graphics_pipeline_t *, IdentityHash> pendingPipelines;    // owning, indexed by pipeline_hash - graphics pipelines being created in the background
+#endif
+
 	le_shader_manager_o *shaderManager = nullptr; // owning
 
 	HashTable<le_gpso_handle, graphics_pipeline_state_o> graphicsPso;
 	HashTable<le_cpso_handle, compute_pipeline_state_o>  computePso;
 	HashTable<le_rtxpso_handle, rtx_pipeline_state_o>    rtxPso;
 
+	HashTable<le_gpso_handle, le_gpso_handle> graphicsPsoFallbacks; // gpso -> fallback gpso, which is used while the pipeline for gpso is pending
+
 	HashMap<VkPipeline>              pipelines;             // indexed by pipeline_hash
 	HashTable<uint64_t, char *>      rtx_shader_group_data; // indexed by pipeline_hash
 	HashMap<le_pipeline_layout_info> pipelineLayoutInfos;
@@ -851,7 +930,87 @@ static std::vector<le_shader_binding_info> shader_modules_merge_bindings( le_sha
 
 // ----------------------------------------------------------------------
 
-static void le_shader_manager_shader_module_update( le_shader_manager_o *self, le_shader_module_o *module ) {
+// Takes a compiler from the pool of compilers - if all compilers are in use,
+// a new compiler is added to the pool. Compilers must be returned to the pool
+// via le_shader_manager_release_compiler.
+static le_shader_compiler_o *le_shader_manager_acquire_compiler( le_shader_manager_o *self ) {
+	std::scoped_lock lock( self->shaderCompilersMtx );
+
+	if ( self->shaderCompilersAvailable.empty() ) {
+		using namespace le_shader_compiler;
+		self->shaderCompilers.push_back( compiler_i.create() );
+		return self->shaderCompilers.back();
+	}
+
+	auto compiler = self->shaderCompilersAvailable.back();
+	self->shaderCompilersAvailable.pop_back();
+
+	return compiler;
+}
+
+// ----------------------------------------------------------------------
+
+static void le_shader_manager_release_compiler( le_shader_manager_o *self, le_shader_compiler_o *compiler ) {
+	std::scoped_lock lock( self->shaderCompilersMtx );
+	self->shaderCompilersAvailable.push_back( compiler );
+}
+
+// ----------------------------------------------------------------------
+// Loads source file for item, and translates it to spir-v.
+// Note: this may be called from any thread.
+static void le_shader_manager_compile_item( le_shader_manager_o *self, le_shader_compile_item_t *item ) {
+
+	if ( item->filepath.empty() ) {
+		return;
+	}
+
+	auto source_text = load_file( item->filepath, &item->loaded );
+
+	if ( !item->loaded ) {
+		// file could not be loaded. bail out.
+		return;
+	}
+
+	item->includes = { item->filepath }; // let first element be the original source file path
+
+	auto compiler = le_shader_manager_acquire_compiler( self );
+
+	translate_to_spirv_code( compiler, source_text.data(), source_text.size(), item->stage, item->filepath.c_str(), item->spirv, item->includes, item->macro_defines );
+
+	le_shader_manager_release_compiler( self, compiler );
+}
+
+// ----------------------------------------------------------------------
+// Compiles all items, and returns once all items have been compiled.
+// With LE_MT > 0, items are compiled concurrently, on le_jobs worker threads.
+static void le_shader_manager_compile_items( le_shader_manager_o *self, le_shader_compile_item_t *items, uint32_t num_items ) {
+#if ( LE_MT > 0 )
+	struct params_t {
+		le_shader_manager_o *     shader_manager;
+		le_shader_compile_item_t *items;
+	};
+
+	params_t params{ self, items };
+
+	auto compile_items_fun = []( uint32_t range_begin, uint32_t range_end, void *user_data ) {
+		auto p = static_cast<params_t *>( user_data );
+		for ( uint32_t i = range_begin; i != range_end; i++ ) {
+			le_shader_manager_compile_item( p->shader_manager, p->items + i );
+		}
+	};
+
+	// grain size of 1, as compiling a single module is already a fairly large chunk of work.
+	le_jobs::parallel_for( 0, num_items, 1, compile_items_fun, &params );
+#else
+	for ( uint32_t i = 0; i != num_items; i++ ) {
+		le_shader_manager_compile_item( self, items + i );
+	}
+#endif
+}
+
+// ----------------------------------------------------------------------
+
+static void le_shader_manager_shader_module_update( le_shader_manager_o *self, le_shader_module_o *module, le_shader_compile_item_t &item ) {
 
 	// Shader module needs updating if shader code has changed.
 	// if this happens, a new vulkan object for the module must be created.
@@ -863,19 +1022,13 @@ static void le_shader_manager_shader_module_update( le_shader_manager_o *self, l
 	// generated from it. This means we "only" need to protect against any threads which might be
 	// creating pipelines.
 
-	// -- get module spirv code
-	bool loadSuccessful = false;
-	auto source_text    = load_file( module->filepath, &loadSuccessful );
-
-	if ( !loadSuccessful ) {
+	if ( !item.loaded ) {
 		// file could not be loaded. bail out.
 		return;
 	}
 
-	std::vector<uint32_t> spirv_code;
-	std::set<std::string> includesSet{ { module->filepath } }; // let first element be the original source file path
-
-	translate_to_spirv_code( self->shader_compiler, source_text.data(), source_text.size(), { module->stage }, module->filepath.c_str(), spirv_code, includesSet, module->macro_defines );
+	std::vector<uint32_t> spirv_code  = std::move( item.spirv );
+	std::set<std::string> includesSet = std::move( item.includes );
 
 	if ( spirv_code.empty() ) {
 		// no spirv code available, bail out.
@@ -933,6 +1086,93 @@ static void le_shader_manager_shader_module_update( le_shader_manager_o *self, l
 	module->module = self->device.createShaderModule( createInfo );
 }
 
+// ----------------------------------------------------------------------
+// Recompiles all modules which have been flagged as modified. With LE_MT > 0,
+// modules are recompiled in the background, as jobs of background priority -
+// modules keep their previous spir-v code and vulkan shader module until results
+// are applied via le_shader_manager_apply_recompile.
+static void le_shader_manager_issue_recompile( le_shader_manager_o *self ) {
+
+	auto batch = new le_shader_compile_batch_o{};
+
+	batch->shader_manager = self;
+	batch->items.reserve( self->modifiedShaderModules.size() );
+
+	for ( auto &m : self->modifiedShaderModules ) {
+		le_shader_compile_item_t item{};
+		item.module        = m;
+		item.filepath      = m->filepath.string();
+		item.stage         = { m->stage };
+		item.macro_defines = m->macro_defines;
+		batch->items.emplace_back( std::move( item ) );
+	}
+
+	self->modifiedShaderModules.clear();
+
+	batch->num_items_pending = uint32_t( batch->items.size() );
+
+#if ( LE_MT > 0 )
+	batch->job_params.reserve( batch->items.size() );
+
+	std::vector<le_jobs::job_t> jobs;
+	jobs.reserve( batch->items.size() );
+
+	auto compile_item_fun = []( void *user_data ) {
+		auto p = static_cast<le_shader_compile_batch_o::job_params_t *>( user_data );
+		le_shader_manager_compile_item( p->batch->shader_manager, p->item );
+		p->batch->num_items_pending.fetch_sub( 1, std::memory_order_release );
+	};
+
+	for ( auto &item : batch->items ) {
+		batch->job_params.push_back( { batch, &item } );
+		jobs.push_back( { compile_item_fun, &batch->job_params.back() } );
+	}
+
+	le_jobs::run_jobs_ex( jobs.data(), uint32_t( jobs.size() ), &batch->counter, LeJobPriority::eBackground, LE_JOB_AFFINITY_ANY );
+#else
+	le_shader_manager_compile_items( self, batch->items.data(), uint32_t( batch->items.size() ) );
+	batch->num_items_pending = 0;
+#endif
+
+	self->pendingRecompile = batch;
+}
+
+// ----------------------------------------------------------------------
+// Applies results of pending recompilation to shader modules - but only once
+// all modules of the pending batch have been compiled. Returns false if
+// recompilation is still in flight.
+static bool le_shader_manager_apply_recompile( le_shader_manager_o *self ) {
+
+	auto batch = self->pendingRecompile;
+
+	if ( batch->num_items_pending.load( std::memory_order_acquire ) != 0 ) {
+		return false;
+	}
+
+	// ----------| invariant: all items have been compiled
+
+#if ( LE_MT > 0 )
+	// Jobs decrement their counter just after they return, which means that
+	// this won't wait for long.
+	le_jobs::wait_for_counter_and_free( batch->counter, 0 );
+#endif
+
+	{
+		// Pipelines may be created on other threads while we update - these must not see
+		// a module while its vulkan object gets replaced.
+		std::unique_lock lock( self->modulesMtx );
+
+		for ( auto &item : batch->items ) {
+			le_shader_manager_shader_module_update( self, item.module, item );
+		}
+	}
+
+	delete batch;
+	self->pendingRecompile = nullptr;
+
+	return true;
+}
+
 // ----------------------------------------------------------------------
 // this method is called via renderer::update - before frame processing.
 static void le_shader_manager_update_shader_modules( le_shader_manager_o *self ) {
@@ -943,13 +1183,16 @@ static void le_shader_manager_update_shader_modules( le_shader_manager_o *self )
 	// callbacks will modify le_backend->modifiedShaderModules
 	le_file_watcher_api_i->le_file_watcher_i.poll_notifications( self->shaderFileWatcher );
 
-	// -- update only modules which have been tainted
+	// -- recompile only modules which have been tainted - modules which get tainted
+	//    while a recompilation is in flight are picked up once it has been applied.
 
-	for ( auto &s : self->modifiedShaderModules ) {
-		le_shader_manager_shader_module_update( self, s );
+	if ( nullptr == self->pendingRecompile && !self->modifiedShaderModules.empty() ) {
+		le_shader_manager_issue_recompile( self );
 	}
 
-	self->modifiedShaderModules.clear();
+	if ( self->pendingRecompile ) {
+		le_shader_manager_apply_recompile( self );
+	}
 }
 
 // ----------------------------------------------------------------------
@@ -959,9 +1202,11 @@ le_shader_manager_o *le_shader_manager_create( VkDevice_T *device ) {
 
 	self->device = device;
 
-	// -- create shader compiler
+	// -- create shader compiler - more compilers are added to the pool
+	//    on demand, if modules get compiled concurrently.
 	using namespace le_shader_compiler;
-	self->shader_compiler = compiler_i.create();
+	self->shaderCompilers.push_back( compiler_i.create() );
+	self->shaderCompilersAvailable = self->shaderCompilers;
 
 	// -- create file watcher for shader files so that changes can be detected
 	self->shaderFileWatcher = le_file_watcher_api_i->le_file_watcher_i.create();
@@ -982,12 +1227,23 @@ static void le_shader_manager_destroy( le_shader_manager_o *self ) {
 		self->shaderFileWatcher = nullptr;
 	}
 
-	if ( self->shader_compiler ) {
-		// -- destroy shader compiler
-		compiler_i.destroy( self->shader_compiler );
-		self->shader_compiler = nullptr;
+	if ( self->pendingRecompile ) {
+		// -- wait for any recompilation in flight, and discard its results
+#if ( LE_MT > 0 )
+		le_jobs::wait_for_counter_and_free( self->pendingRecompile->counter, 0 );
+#endif
+		delete self->pendingRecompile;
+		self->pendingRecompile = nullptr;
 	}
 
+	// -- destroy shader compilers
+
+	for ( auto &c : self->shaderCompilers ) {
+		compiler_i.destroy( c );
+	}
+	self->shaderCompilers.clear();
+	self->shaderCompilersAvailable.clear();
+
 	// -- destroy retained shader modules
 
 	for ( auto &s : self->shaderModules ) {
@@ -1002,44 +1258,26 @@ static void le_shader_manager_destroy( le_shader_manager_o *self ) {
 }
 
 // ----------------------------------------------------------------------
-/// \brief create vulkan shader module based on file path
-/// \details FIXME: this method can get called nearly anywhere - it should not be publicly accessible.
-/// ideally, this method is only allowed to be called in the setup phase.
-///
-/// TODO: consider handing out an opaque handle instead of a pointer for shader_module, so that it becomes
-/// clear that the object is owned by the backend, and must not be deleted or directly accessed outside.
-static le_shader_module_o *le_shader_manager_create_shader_module( le_shader_manager_o *self, char const *path, const LeShaderStageEnum &moduleType, char const *macro_defines_ ) {
+// Creates a shader module from a compiled item - returns a previously created
+// module if a module with identical hash already exists.
+static le_shader_module_o *le_shader_manager_create_shader_module_from_item( le_shader_manager_o *self, le_shader_compile_item_t &item ) {
 
-	// This method gets called through the renderer - it is assumed during the setup stage.
-
-	bool loadSuccessful = false;
-	auto raw_file_data  = load_file( path, &loadSuccessful ); // returns a raw byte vector
-
-	if ( !loadSuccessful ) {
+	if ( !item.loaded ) {
 		return nullptr;
 	}
 
 	// ---------| invariant: load was successful
 
-	// We use the canonical path to store a fingerprint of the file
-	auto canonical_path_as_string = std::filesystem::canonical( path ).string();
-
-	// -- Make sure the file contains spir-v code.
-
-	std::vector<uint32_t> spirv_code;
-	std::set<std::string> includesSet = { { canonical_path_as_string } }; // let first element be the source file path
-
-	std::string macro_defines = macro_defines_ ? std::string( macro_defines_ ) : "";
-
-	translate_to_spirv_code( self->shader_compiler, raw_file_data.data(), raw_file_data.size(), moduleType, path, spirv_code, includesSet, macro_defines );
+	std::vector<uint32_t> spirv_code  = std::move( item.spirv );
+	std::set<std::string> includesSet = std::move( item.includes );
 
 	// FIXME: we need to check spirv code is ok, that compilation succeeded.
 
 	le_shader_module_o *module = new le_shader_module_o{};
 
-	module->stage         = moduleType;
-	module->filepath      = canonical_path_as_string;
-	module->macro_defines = macro_defines;
+	module->stage         = item.stage;
+	module->filepath      = item.filepath;
+	module->macro_defines = item.macro_defines;
 
 	module->hash_file_path      = SpookyHash::Hash64( module->filepath.string().data(), module->filepath.string().size(), 0 );
 	module->hash_shader_defines = SpookyHash::Hash64( module->macro_defines.data(), module->macro_defines.size(), 0 );
@@ -1096,6 +1334,61 @@ static le_shader_module_o *le_shader_manager_create_shader_module( le_shader_man
 	return module;
 }
 
+// ----------------------------------------------------------------------
+/// \brief create vulkan shader modules based on file paths
+/// \details Source files are compiled concurrently - if LE_MT > 0 - which is much faster than
+/// creating modules one-by-one if many modules need to be compiled, e.g. at startup.
+///
+/// `macro_defines` may be nullptr, as may be any of its elements. Each element of `modules`
+/// receives the module for the corresponding path, or nullptr if the module could not be created.
+static void le_shader_manager_create_shader_modules( le_shader_manager_o *self, uint32_t num_modules, char const *const *paths, LeShaderStageEnum const *moduleTypes, char const *const *macro_defines, le_shader_module_o **modules ) {
+
+	// This method gets called through the renderer - it is assumed during the setup stage.
+
+	std::vector<le_shader_compile_item_t> items( num_modules );
+
+	for ( uint32_t i = 0; i != num_modules; i++ ) {
+
+		auto &item = items[ i ];
+
+		// We use the canonical path to store a fingerprint of the file
+		std::error_code ec;
+		auto            canonical_path = std::filesystem::canonical( paths[ i ], ec );
+
+		if ( ec ) {
+			std::cerr << "Unable to open file: " << paths[ i ] << std::endl
+			          << std::flush;
+			continue; // item with empty filepath won't get compiled
+		}
+
+		item.filepath      = canonical_path.string();
+		item.stage         = moduleTypes[ i ];
+		item.macro_defines = ( macro_defines && macro_defines[ i ] ) ? std::string( macro_defines[ i ] ) : "";
+	}
+
+	le_shader_manager_compile_items( self, items.data(), num_modules );
+
+	// -- create modules in order, so that duplicate modules within this batch are
+	//    detected as such.
+
+	for ( uint32_t i = 0; i != num_modules; i++ ) {
+		modules[ i ] = le_shader_manager_create_shader_module_from_item( self, items[ i ] );
+	}
+}
+
+// ----------------------------------------------------------------------
+/// \brief create vulkan shader module based on file path
+/// \details FIXME: this method can get called nearly anywhere - it should not be publicly accessible.
+/// ideally, this method is only allowed to be called in the setup phase.
+///
+/// TODO: consider handing out an opaque handle instead of a pointer for shader_module, so that it becomes
+/// clear that the object is owned by the backend, and must not be deleted or directly accessed outside.
+static le_shader_module_o *le_shader_manager_create_shader_module( le_shader_manager_o *self, char const *path, const LeShaderStageEnum &moduleType, char const *macro_defines_ ) {
+	le_shader_module_o *module = nullptr;
+	le_shader_manager_create_shader_modules( self, 1, &path, &moduleType, &macro_defines_, &module );
+	return module;
+}
+
 // ----------------------------------------------------------------------
 // called via decoder / produce_frame -
 static vk::PipelineLayout le_pipeline_manager_get_pipeline_layout( le_pipeline_manager_o *self, le_shader_module_o const *const *shader_modules, size_t numModules ) {
@@ -1224,8 +1517,19 @@ static inline vk::ShaderStageFlagBits le_to_vk( const le::ShaderStage &stage ) {
 // ----------------------------------------------------------------------
 // Creates a vulkan graphics pipeline based on a shader state object and a given renderpass and subpass index.
 //
+static void le_pipeline_manager_count_pipeline_creation( le_pipeline_manager_o *self, std::chrono::steady_clock::time_point const &t_start ) {
+	auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - t_start );
+	self->pipelinesCreatedTimeNanoseconds += uint64_t( duration.count() );
+	self->pipelinesCreatedCount++;
+}
+
+// ----------------------------------------------------------------------
+
 static vk::Pipeline le_pipeline_cache_create_graphics_pipeline( le_pipeline_manager_o *self, graphics_pipeline_state_o const *pso, const LeRenderPass &pass, uint32_t subpass ) {
 
+	// Shader modules must not be updated while we use them to create a pipeline.
+	std::shared_lock modules_lock( self->shaderManager->modulesMtx );
+
 	std::vector<vk::PipelineShaderStageCreateInfo> pipelineStages;
 	pipelineStages.reserve( pso->shaderStages.size() );
 
@@ -1371,7 +1675,10 @@ static vk::Pipeline le_pipeline_cache_create_graphics_pipeline( le_pipeline_mana
 	    .setBasePipelineIndex( 0 )                                 // -1 signals not to use a base pipeline index
 	    ;
 
+	auto t_start  = std::chrono::steady_clock::now();
 	auto pipeline = self->device.createGraphicsPipeline( self->vulkanCache, gpi );
+	le_pipeline_manager_count_pipeline_creation( self, t_start );
+
 	return pipeline;
 }
 
@@ -1379,6 +1686,9 @@ static vk::Pipeline le_pipeline_cache_create_graphics_pipeline( le_pipeline_mana
 
 static vk::Pipeline le_pipeline_cache_create_compute_pipeline( le_pipeline_manager_o *self, compute_pipeline_state_o const *pso ) {
 
+	// Shader modules must not be updated while we use them to create a pipeline.
+	std::shared_lock modules_lock( self->shaderManager->modulesMtx );
+
 	// Fetch vk::PipelineLayout for this pso
 	auto pipelineLayout = le_pipeline_manager_get_pipeline_layout( self, &pso->shaderStage, 1 );
 
@@ -1400,7 +1710,10 @@ static vk::Pipeline le_pipeline_cache_create_compute_pipeline( le_pipeline_manag
 	    .setBasePipelineIndex( 0 ) // -1 signals not to use base pipeline index
 	    ;
 
+	auto t_start  = std::chrono::steady_clock::now();
 	auto pipeline = self->device.createComputePipeline( self->vulkanCache, cpi );
+	le_pipeline_manager_count_pipeline_creation( self, t_start );
+
 	return pipeline;
 }
 
@@ -1425,6 +1738,9 @@ static vk::RayTracingShaderGroupTypeKHR le_to_vk( le::RayTracingShaderGroupType
 #ifdef LE_FEATURE_RTX
 static vk::Pipeline le_pipeline_cache_create_rtx_pipeline( le_pipeline_manager_o *self, rtx_pipeline_state_o const *pso ) {
 
+	// Shader modules must not be updated while we use them to create a pipeline.
+	std::shared_lock modules_lock( self->shaderManager->modulesMtx );
+
 	// Fetch vk::PipelineLayout for this pso
 	auto pipelineLayout = le_pipeline_manager_get_pipeline_layout( self, pso->shaderStages.data(), pso->shaderStages.size() );
 
@@ -1482,7 +1798,10 @@ static vk::Pipeline le_pipeline_cache_create_rtx_pipeline( le_pipeline_manager_o
 	    .setBasePipelineHandle( nullptr )
 	    .setBasePipelineIndex( 0 );
 
-	auto result = self->device.createRayTracingPipelineKHR( self->vulkanCache, create_info );
+	auto t_start = std::chrono::steady_clock::now();
+	auto result  = self->device.createRayTracingPipelineKHR( self->vulkanCache, create_info );
+	le_pipeline_manager_count_pipeline_creation( self, t_start );
+
 	assert( vk::Result::eSuccess == result.result );
 	return result.value;
 }
@@ -1756,7 +2075,112 @@ static inline bool le_pipeline_manager_get_pipeline_layout_info(
 //
 // + NOTE: Access to this method must be sequential - no two frames may access this method
 //   at the same time - and no two renderpasses may access this method at the same time.
-static le_pipeline_and_layout_info_t le_pipeline_manager_produce_graphics_pipeline( le_pipeline_manager_o *self, le_gpso_handle gpso_handle, const LeRenderPass &pass, uint32_t subpass ) {
+// Stores pipeline in cache under `pipeline_hash`. If a pipeline with this hash was stored in the
+// meantime - by another thread - we destroy our pipeline, and return the stored pipeline instead.
+static VkPipeline le_pipeline_manager_store_pipeline( le_pipeline_manager_o *self, uint64_t pipeline_hash, VkPipeline pipeline ) {
+
+	if ( self->pipelines.try_insert( pipeline_hash, &pipeline ) ) {
+		return pipeline;
+	}
+
+	self->device.destroyPipeline( pipeline );
+
+	auto p = self->pipelines.try_find( pipeline_hash );
+	assert( p && "pipeline must be in cache if insertion failed" );
+
+	return *p;
+}
+
+// ----------------------------------------------------------------------
+
+#if ( LE_MT > 0 )
+// Issues a job which creates a graphics pipeline in the background, and stores it
+// in the pipeline cache once complete - unless a job for this pipeline is already in flight.
+static void le_pipeline_manager_issue_graphics_pipeline( le_pipeline_manager_o *self, graphics_pipeline_state_o const *pso, const LeRenderPass &pass, uint32_t subpass, uint64_t pipeline_hash ) {
+
+	std::scoped_lock lock( self->pendingPipelinesMtx );
+
+	auto &pending = self->pendingPipelines[ pipeline_hash ];
+
+	if ( pending ) {
+		// pipeline is already being created.
+		return;
+	}
+
+	// ---------| invariant: no job in flight for this pipeline
+
+	self->pipelinesRequestedCount++;
+
+	pending = new le_pending_graphics_pipeline_t{};
+
+	pending->pipeline_manager = self;
+	pending->pso              = pso;
+	pending->subpass          = subpass;
+	pending->pipeline_hash    = pipeline_hash;
+
+	// We only copy what pipeline creation needs from pass - the vk renderpass is owned
+	// by the backend's object cache, which outlives the pipeline manager.
+	pending->pass.renderPass          = pass.renderPass;
+	pending->pass.renderpassHash      = pass.renderpassHash;
+	pending->pass.numColorAttachments = pass.numColorAttachments;
+	pending->pass.sampleCount         = pass.sampleCount;
+	pending->pass.type                = pass.type;
+
+	auto create_pipeline_fun = []( void *user_data ) {
+		auto p = static_cast<le_pending_graphics_pipeline_t *>( user_data );
+
+		VkPipeline pipeline = le_pipeline_cache_create_graphics_pipeline( p->pipeline_manager, p->pso, p->pass, p->subpass );
+
+		le_pipeline_manager_store_pipeline( p->pipeline_manager, p->pipeline_hash, pipeline );
+
+		std::cout << "New VK Graphics Pipeline created: 0x" << std::hex << p->pipeline_hash << " (async)" << std::endl
+		          << std::flush;
+
+		p->is_complete.store( true, std::memory_order_release );
+	};
+
+	le_jobs::job_t job{ create_pipeline_fun, pending };
+
+	// Pipelines are needed as soon as possible, but should not delay work
+	// which the current frame is waiting for.
+	le_jobs::run_jobs_ex( &job, 1, &pending->counter, LeJobPriority::eNormal, LE_JOB_AFFINITY_ANY );
+}
+
+// ----------------------------------------------------------------------
+// Frees pending pipeline entries for which creation is complete.
+// If `wait_for_all` is true, waits for all pipelines in flight to complete.
+static void le_pipeline_manager_retire_pending_pipelines( le_pipeline_manager_o *self, bool wait_for_all ) {
+
+	std::vector<le_pending_graphics_pipeline_t *> retired;
+
+	{
+		std::scoped_lock lock( self->pendingPipelinesMtx );
+
+		for ( auto it = self->pendingPipelines.begin(); it != self->pendingPipelines.end(); ) {
+			auto pending = it->second;
+			if ( wait_for_all || pending->is_complete.load( std::memory_order_acquire ) ) {
+				retired.push_back( pending );
+				it = self->pendingPipelines.erase( it );
+			} else {
+				it++;
+			}
+		}
+	}
+
+	// We must not hold the mutex while we wait: waiting may switch fibers, and another
+	// fiber on this thread might then try to lock the mutex again.
+	for ( auto &pending : retired ) {
+		le_jobs::wait_for_counter_and_free( pending->counter, 0 );
+		delete pending;
+	}
+}
+#endif
+
+// ----------------------------------------------------------------------
+// If `allow_async` is true, pipelines which are not yet in cache are created in the
+// background (if LE_MT > 0) - in the meantime, we return the fallback pipeline for this
+// pso if one was registered, or a nullptr pipeline if there is no fallback.
+static le_pipeline_and_layout_info_t le_pipeline_manager_produce_graphics_pipeline_internal( le_pipeline_manager_o *self, le_gpso_handle gpso_handle, const LeRenderPass &pass, uint32_t subpass, bool allow_async ) {
 
 	le_pipeline_and_layout_info_t pipeline_and_layout_info = {};
 
@@ -1799,21 +2223,76 @@ static le_pipeline_and_layout_info_t le_pipeline_manager_produce_graphics_pipeli
 	if ( p ) {
 		// pipeline exists
 		pipeline_and_layout_info.pipeline = *p;
-	} else {
-		// -- if not, create pipeline in pipeline cache and store / retain it
-		pipeline_and_layout_info.pipeline = le_pipeline_cache_create_graphics_pipeline( self, pso, pass, subpass );
+		return pipeline_and_layout_info;
+	}
 
-		std::cout << "New VK Graphics Pipeline created: 0x" << std::hex << pipeline_hash << std::endl
-		          << std::flush;
+	// ---------| invariant: pipeline is not in cache
 
-		bool result = self->pipelines.try_insert( pipeline_hash, &pipeline_and_layout_info.pipeline );
+#if ( LE_MT > 0 )
+	if ( allow_async ) {
+
+		le_pipeline_manager_issue_graphics_pipeline( self, pso, pass, subpass, pipeline_hash );
+
+		// -- while pipeline is pending, substitute fallback pipeline, if any
+		auto fallback_gpso_handle = self->graphicsPsoFallbacks.try_find( gpso_handle );
 
-		assert( result && " pipeline insertion must be successful " );
+		if ( fallback_gpso_handle && *fallback_gpso_handle != gpso_handle ) {
+			// Fallback pipeline is created synchronously if it does not exist yet.
+			return le_pipeline_manager_produce_graphics_pipeline_internal( self, *fallback_gpso_handle, pass, subpass, false );
+		}
+
+		// -- no fallback: caller must skip any draws which depend on this pipeline.
+		pipeline_and_layout_info.pipeline = nullptr;
+		return pipeline_and_layout_info;
 	}
+#endif
+
+	// -- create pipeline in pipeline cache and store / retain it - this stalls the caller
+	self->pipelinesStalledCount++;
+	pipeline_and_layout_info.pipeline = le_pipeline_manager_store_pipeline( self, pipeline_hash, le_pipeline_cache_create_graphics_pipeline( self, pso, pass, subpass ) );
+
+	std::cout << "New VK Graphics Pipeline created: 0x" << std::hex << pipeline_hash << std::endl
+	          << std::flush;
 
 	return pipeline_and_layout_info;
 }
 
+// ----------------------------------------------------------------------
+// Returns a nullptr pipeline if pipeline is still being created, and no fallback pipeline has
+// been set for `gpso_handle` - in which case any draws using this pipeline must be skipped.
+static le_pipeline_and_layout_info_t le_pipeline_manager_produce_graphics_pipeline( le_pipeline_manager_o *self, le_gpso_handle gpso_handle, const LeRenderPass &pass, uint32_t subpass ) {
+	return le_pipeline_manager_produce_graphics_pipeline_internal( self, gpso_handle, pass, subpass, true );
+}
+
+// ----------------------------------------------------------------------
+// Sets a graphics pipeline which is used in place of `gpso_handle` while the pipeline for
+// `gpso_handle` is being created. Returns false if a fallback was already set for `gpso_handle`.
+static bool le_pipeline_manager_set_graphics_pipeline_fallback( le_pipeline_manager_o *self, le_gpso_handle gpso_handle, le_gpso_handle fallback_gpso_handle ) {
+	return self->graphicsPsoFallbacks.try_insert( gpso_handle, &fallback_gpso_handle );
+}
+
+// ----------------------------------------------------------------------
+
+static void le_pipeline_manager_get_stats( le_pipeline_manager_o *self, le_pipeline_manager_stats_t *stats ) {
+
+	stats->pipelines_pending = 0;
+
+#if ( LE_MT > 0 )
+	{
+		std::scoped_lock lock( self->pendingPipelinesMtx );
+		for ( auto const &p : self->pendingPipelines ) {
+			if ( !p.second->is_complete.load( std::memory_order_acquire ) ) {
+				stats->pipelines_pending++;
+			}
+		}
+	}
+#endif
+
+	stats->pipelines_compiled  = self->pipelinesCreatedCount;
+	stats->pipelines_stalled   = self->pipelinesStalledCount;
+	stats->pipelines_requested = self->pipelinesRequestedCount;
+}
+
 /// \brief Creates - or loads a pipeline from cache - based on current pipeline state
 /// \note This method may lock the pso cache and is therefore costly.
 //
@@ -2044,8 +2523,133 @@ static le_shader_module_o *le_pipeline_manager_create_shader_module( le_pipeline
 
 // ----------------------------------------------------------------------
 
+static void le_pipeline_manager_create_shader_modules( le_pipeline_manager_o *self, uint32_t num_modules, char const *const *paths, LeShaderStageEnum const *moduleTypes, char const *const *macro_definitions, le_shader_module_o **modules ) {
+	le_shader_manager_create_shader_modules( self->shaderManager, num_modules, paths, moduleTypes, macro_definitions, modules );
+}
+
+// ----------------------------------------------------------------------
+// Pipeline cache data is only valid for the exact device and driver version
+// which produced it - this is why we key the cache file by both.
+//
+// Cache files live in a `pipeline_cache` directory next to the executable.
+static std::filesystem::path pipeline_cache_get_file_path( VkPhysicalDeviceProperties const &props ) {
+
+	std::error_code ec;
+
+	auto exe_path = std::filesystem::read_symlink( "/proc/self/exe", ec );
+
+	if ( ec ) {
+		return {};
+	}
+
+	std::ostringstream filename;
+	filename << "pipeline_cache_";
+	for ( auto const &b : props.pipelineCacheUUID ) {
+		filename << std::hex << std::setw( 2 ) << std::setfill( '0' ) << uint32_t( b );
+	}
+	filename << "_" << std::hex << std::setw( 8 ) << std::setfill( '0' ) << props.driverVersion << ".bin";
+
+	return exe_path.parent_path() / "pipeline_cache" / filename.str();
+}
+
+// ----------------------------------------------------------------------
+// Checks pipeline cache header against current device - some drivers don't
+// validate initial data for pipeline caches, and will crash if the data
+// was produced by a different device or driver.
+static bool pipeline_cache_data_is_valid( std::vector<char> const &data, VkPhysicalDeviceProperties const &props ) {
+
+	// Header layout as defined by the Vulkan spec for VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+	struct pipeline_cache_header_t {
+		uint32_t header_size;
+		uint32_t header_version;
+		uint32_t vendor_id;
+		uint32_t device_id;
+		uint8_t  pipeline_cache_uuid[ VK_UUID_SIZE ];
+	};
+
+	if ( data.size() < sizeof( pipeline_cache_header_t ) ) {
+		return false;
+	}
+
+	pipeline_cache_header_t header;
+	memcpy( &header, data.data(), sizeof( pipeline_cache_header_t ) );
+
+	return header.header_size >= sizeof( pipeline_cache_header_t ) &&
+	       header.header_size <= data.size() &&
+	       header.header_version == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+	       header.vendor_id == props.vendorID &&
+	       header.device_id == props.deviceID &&
+	       0 == memcmp( header.pipeline_cache_uuid, props.pipelineCacheUUID, VK_UUID_SIZE );
+}
+
+// ----------------------------------------------------------------------
+// Write pipeline cache data to disk - we write to a temporary file first, which we
+// then rename, so that an interrupted write can never leave a corrupted cache file.
+static void le_pipeline_manager_save_pipeline_cache( le_pipeline_manager_o *self ) {
+
+	if ( self->vulkanCacheFilePath.empty() ) {
+		return;
+	}
+
+	uint64_t pipelines_count = self->pipelinesCreatedCount;
+
+	auto data = self->device.getPipelineCacheData( self->vulkanCache );
+
+	std::error_code ec;
+	std::filesystem::create_directories( self->vulkanCacheFilePath.parent_path(), ec );
+
+	auto tmp_path = self->vulkanCacheFilePath;
+	tmp_path += ".tmp";
+
+	{
+		std::ofstream file( tmp_path, std::ios::out | std::ios::binary | std::ios::trunc );
+		if ( !file.is_open() ) {
+			std::cerr << "WARNING: Could not write pipeline cache file: " << tmp_path << std::endl
+			          << std::flush;
+			return;
+		}
+		file.write( reinterpret_cast<char const *>( data.data() ), std::streamsize( data.size() ) );
+		if ( !file.good() ) {
+			std::cerr << "WARNING: Could not write pipeline cache file: " << tmp_path << std::endl
+			          << std::flush;
+			file.close();
+			std::filesystem::remove( tmp_path, ec );
+			return;
+		}
+	}
+
+	std::filesystem::rename( tmp_path, self->vulkanCacheFilePath, ec );
+
+	if ( ec ) {
+		std::cerr << "WARNING: Could not write pipeline cache file: " << self->vulkanCacheFilePath << ": " << ec.message() << std::endl
+		          << std::flush;
+		std::filesystem::remove( tmp_path, ec );
+		return;
+	}
+
+	self->vulkanCacheLastSaveTime             = std::chrono::steady_clock::now();
+	self->vulkanCachePipelinesCountAtLastSave = pipelines_count;
+}
+
+// ----------------------------------------------------------------------
+
 static void le_pipeline_manager_update_shader_modules( le_pipeline_manager_o *self ) {
 	le_shader_manager_update_shader_modules( self->shaderManager );
+
+#if ( LE_MT > 0 )
+	// Free bookkeeping for pipelines which have been created in the background.
+	le_pipeline_manager_retire_pending_pipelines( self, false );
+#endif
+
+	// Periodically save pipeline cache, if any new pipelines were created since the last save -
+	// so that we don't lose pipelines if the application does not exit cleanly.
+
+	constexpr auto PIPELINE_CACHE_SAVE_INTERVAL = std::chrono::seconds( 30 );
+
+	if ( self->pipelinesCreatedCount != self->vulkanCachePipelinesCountAtLastSave &&
+	     std::chrono::steady_clock::now() - self->vulkanCacheLastSaveTime > PIPELINE_CACHE_SAVE_INTERVAL ) {
+		le_pipeline_manager_save_pipeline_cache( self );
+	}
 }
 
 // ----------------------------------------------------------------------
@@ -2058,11 +2662,34 @@ static le_pipeline_manager_o *le_pipeline_manager_create( le_device_o *le_device
 	vk_device_i.increase_reference_count( le_device );
 	self->device = vk_device_i.get_vk_device( le_device );
 
+	// Load pipeline cache data from a previous run, if available and valid for the current device.
+
+	auto const &physicalDeviceProperties = vk_device_i.get_vk_physical_device_properties( le_device );
+
+	self->vulkanCacheFilePath     = pipeline_cache_get_file_path( physicalDeviceProperties );
+	self->vulkanCacheLastSaveTime = std::chrono::steady_clock::now();
+
+	std::vector<char> pipelineCacheData;
+
+	if ( !self->vulkanCacheFilePath.empty() && std::filesystem::exists( self->vulkanCacheFilePath ) ) {
+		bool loaded       = false;
+		pipelineCacheData = load_file( self->vulkanCacheFilePath, &loaded );
+
+		if ( !loaded || !pipeline_cache_data_is_valid( pipelineCacheData, physicalDeviceProperties ) ) {
+			std::cerr << "WARNING: Ignoring invalid pipeline cache file: " << self->vulkanCacheFilePath << std::endl
+			          << std::flush;
+			pipelineCacheData.clear();
+		} else {
+			std::cout << "Loaded pipeline cache: " << self->vulkanCacheFilePath << " (" << std::dec << pipelineCacheData.size() << " bytes)" << std::endl
+			          << std::flush;
+		}
+	}
+
 	vk::PipelineCacheCreateInfo pipelineCacheInfo;
 	pipelineCacheInfo
 	    .setFlags( vk::PipelineCacheCreateFlags() ) // "reserved for future use"
-	    .setInitialDataSize( 0 )
-	    .setPInitialData( nullptr );
+	    .setInitialDataSize( pipelineCacheData.size() )
+	    .setPInitialData( pipelineCacheData.empty() ? nullptr : pipelineCacheData.data() );
 
 	self->vulkanCache   = self->device.createPipelineCache( pipelineCacheInfo );
 	self->shaderManager = le_shader_manager_create( self->device );
@@ -2074,6 +2701,11 @@ static le_pipeline_manager_o *le_pipeline_manager_create( le_device_o *le_device
 
 static void le_pipeline_manager_destroy( le_pipeline_manager_o *self ) {
 
+#if ( LE_MT > 0 )
+	// Pipelines in flight use shader modules, and the pipeline cache - wait for them to complete.
+	le_pipeline_manager_retire_pending_pipelines( self, true );
+#endif
+
 	le_shader_manager_destroy( self->shaderManager );
 	self->shaderManager = nullptr;
 
@@ -2127,9 +2759,14 @@ static void le_pipeline_manager_destroy( le_pipeline_manager_o *self ) {
 	    },
 	    nullptr );
 
-	// Destroy Pipeline Cache
+	// Save and destroy Pipeline Cache
+
+	std::cout << "Created " << std::dec << self->pipelinesCreatedCount << " pipelines in "
+	          << std::fixed << std::setprecision( 2 ) << double( self->pipelinesCreatedTimeNanoseconds ) / 1'000'000.0 << "ms" << std::endl
+	          << std::flush;
 
 	if ( self->vulkanCache ) {
+		le_pipeline_manager_save_pipeline_cache( self );
 		self->device.destroyPipelineCache( self->vulkanCache );
 	}
 
@@ -2151,6 +2788,7 @@ void register_le_pipeline_vk_api( void *api_ ) {
 		i.destroy = le_pipeline_manager_destroy;
 
 		i.create_shader_module              = le_pipeline_manager_create_shader_module;
+		i.create_shader_modules             = le_pipeline_manager_create_shader_modules;
 		i.update_shader_modules             = le_pipeline_manager_update_shader_modules;
 		i.introduce_graphics_pipeline_state = le_pipeline_manager_introduce_graphics_pipeline_state;
 		i.introduce_compute_pipeline_state  = le_pipeline_manager_introduce_compute_pipeline_state;
@@ -2160,6 +2798,8 @@ void register_le_pipeline_vk_api( void *api_ ) {
 		i.produce_graphics_pipeline         = le_pipeline_manager_produce_graphics_pipeline;
 		i.produce_rtx_pipeline              = le_pipeline_manager_produce_rtx_pipeline;
 		i.produce_compute_pipeline          = le_pipeline_manager_produce_compute_pipeline;
+		i.set_graphics_pipeline_fallback    = le_pipeline_manager_set_graphics_pipeline_fallback;
+		i.get_stats                         = le_pipeline_manager_get_stats;
 	}
 	{
 		auto &i     = le_backend_vk_api_i->le_shader_module_i;
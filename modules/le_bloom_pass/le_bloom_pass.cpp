@@ -12,6 +12,7 @@
 #include "gtc/matrix_transform.hpp"
 
 #include <algorithm> // for min/max
+#include <array>
 
 static void
 le_render_module_add_blit_pass(
@@ -181,13 +182,18 @@ le_render_module_add_bloom_pass(
 		};
 
 		static le_shader_module_o *quadVert           = le_backend_vk::le_pipeline_manager_i.create_shader_module( pm, "./resources/shaders/fullscreenQuad.vert", { le::ShaderStage::eVertex }, "" );
-		static le_shader_module_o *gaussianBlurFrag[] = {
-		    le_backend_vk::le_pipeline_manager_i.create_shader_module( pm, "./resources/shaders/blur.frag", { le::ShaderStage::eFragment }, BLUR_KERNEL_DEFINES[ 0 ] ),
-		    le_backend_vk::le_pipeline_manager_i.create_shader_module( pm, "./resources/shaders/blur.frag", { le::ShaderStage::eFragment }, BLUR_KERNEL_DEFINES[ 1 ] ),
-		    le_backend_vk::le_pipeline_manager_i.create_shader_module( pm, "./resources/shaders/blur.frag", { le::ShaderStage::eFragment }, BLUR_KERNEL_DEFINES[ 2 ] ),
-		    le_backend_vk::le_pipeline_manager_i.create_shader_module( pm, "./resources/shaders/blur.frag", { le::ShaderStage::eFragment }, BLUR_KERNEL_DEFINES[ 3 ] ),
-		    le_backend_vk::le_pipeline_manager_i.create_shader_module( pm, "./resources/shaders/blur.frag", { le::ShaderStage::eFragment }, BLUR_KERNEL_DEFINES[ 4 ] ),
-		};
+		// Create all kernel variants in one batch, so that they may be compiled concurrently.
+		static auto gaussianBlurFrag = [ pm ]() {
+			std::array<le_shader_module_o *, 5> modules{};
+			char const *                        paths[ 5 ];
+			LeShaderStageEnum                   stages[ 5 ];
+			for ( size_t i = 0; i != 5; i++ ) {
+				paths[ i ]  = "./resources/shaders/blur.frag";
+				stages[ i ] = { le::ShaderStage::eFragment };
+			}
+			le_backend_vk::le_pipeline_manager_i.create_shader_modules( pm, 5, paths, stages, BLUR_KERNEL_DEFINES, modules.data() );
+			return modules;
+		}();
 
 		struct BlurParams {
 			glm::vec2 resolution;
@@ -243,6 +249,30 @@ le_render_module_add_bloom_pass(
 		    .draw( 4 );
 	};
 
+	// -- Declare blur targets transient: their contents are only used within the
+	// current frame, which allows the backend to let them share memory.
+	//
+	// Blur targets at index i have 1/2^(i+1) of the input resolution.
+
+	{
+		uint32_t w = width;
+		uint32_t h = height;
+
+		for ( size_t i = 0; i != 5; i++ ) {
+
+			w = std::max<uint32_t>( 1, w / 2 );
+			h = std::max<uint32_t>( 1, h / 2 );
+
+			auto blurTargetInfo = le::ImageInfoBuilder()
+			                          .setExtent( w, h )
+			                          .setIsTransient()
+			                          .build();
+
+			render_module_i.declare_resource( module, targets_blur_h[ i ].image, blurTargetInfo );
+			render_module_i.declare_resource( module, targets_blur_v[ i ].image, blurTargetInfo );
+		}
+	}
+
 	// -- First, have a pass which filters out anything which is not bright. (do this at half resolution)
 	// -- Then, blur and scale down image 5 times
 	// -- Finally, combine the main image with the blurred image
@@ -3,23 +3,164 @@
 #include "le_file_watcher/le_file_watcher.h"
 #include "hash_util.h"
 #include <vector>
+#include <string.h> // for strdup
 #include <string>
+#include <atomic>
+#include <mutex>
 #include <stdio.h>
 #include <iostream>
 #include <iomanip>
 #include <array>
 #include <assert.h>
 
+/* Open-addressing hash table, which maps 64 bit hashes to pointers.
+ *
+ * Keys are hashes which were already computed (fnv1a, see hash_util.h),
+ * so that we don't hash again, we only mix bits before probing. Key 0
+ * marks an empty slot, and may not be used as a key.
+ *
+ * Lookups are lock-free, and safe while another thread inserts: inserts
+ * write a slot's value before publishing its key, and once a table grows,
+ * the old table is kept alive (it still holds valid entries) until the
+ * HashTable gets destroyed. Inserts must not run concurrently with other
+ * inserts.
+ *
+ * Entries can't be removed, and values can't be changed once inserted.
+ *
+ * Modules may register their apis during static initialisation of other
+ * compilation units - which is why HashTable has no constructor which must
+ * run, and allocates its first table on first insert.
+ */
+class HashTable : NoCopy, NoMove {
+
+	struct Slot {
+		std::atomic<uint64_t> key{ 0 };
+		std::atomic<void *>   value{ nullptr };
+	};
+
+	struct Table {
+		size_t mask;  // capacity - 1, capacity is a power of 2
+		Slot * slots; //
+	};
+
+	static constexpr size_t INITIAL_CAPACITY = 256;
+
+	std::atomic<Table *> table{ nullptr }; // current table
+	std::vector<Table *> retired_tables;   // tables which were replaced when growing; readers may still be looking at them
+	std::atomic<size_t>  num_entries{ 0 };
+
+	static inline size_t slot_index( uint64_t key, size_t mask ) {
+		return size_t( key ^ ( key >> 29 ) ^ ( key >> 47 ) ) & mask;
+	}
+
+	static Table *table_create( size_t capacity ) {
+		return new Table{ capacity - 1, new Slot[ capacity ] };
+	}
+
+	static void table_destroy( Table *t ) {
+		delete[] t->slots;
+		delete t;
+	}
+
+	// Store entry in table `t` - table must have at least one empty slot, and must not contain key.
+	static void table_insert( Table *t, uint64_t key, void *value ) {
+		for ( size_t i = slot_index( key, t->mask );; i = ( i + 1 ) & t->mask ) {
+			Slot &slot = t->slots[ i ];
+			if ( slot.key.load( std::memory_order_relaxed ) == 0 ) {
+				slot.value.store( value, std::memory_order_relaxed );
+				slot.key.store( key, std::memory_order_release ); // publish entry
+				return;
+			}
+		}
+	}
+
+  public:
+	~HashTable() {
+		if ( table.load() ) {
+			table_destroy( table.load() );
+		}
+		for ( auto t : retired_tables ) {
+			table_destroy( t );
+		}
+	}
+
+	size_t size() const {
+		return num_entries.load( std::memory_order_acquire );
+	}
+
+	// Returns value for key, or nullptr if no entry for key exists.
+	void *find( uint64_t key ) const {
+		assert( key != 0 && "key 0 is reserved for empty slots" );
+
+		Table const *t = table.load( std::memory_order_acquire );
+
+		if ( t == nullptr ) {
+			return nullptr;
+		}
+
+		for ( size_t i = slot_index( key, t->mask );; i = ( i + 1 ) & t->mask ) {
+			Slot const &   slot     = t->slots[ i ];
+			const uint64_t slot_key = slot.key.load( std::memory_order_acquire );
+			if ( slot_key == key ) {
+				return slot.value.load( std::memory_order_relaxed );
+			}
+			if ( slot_key == 0 ) {
+				return nullptr;
+			}
+		}
+	}
+
+	// Adds a new entry - key must not already be in table.
+	void insert( uint64_t key, void *value ) {
+		assert( key != 0 && "key 0 is reserved for empty slots" );
+		assert( find( key ) == nullptr && "key already in table" );
+
+		Table *t = table.load( std::memory_order_relaxed );
+
+		if ( t == nullptr ) {
+			t = table_create( INITIAL_CAPACITY );
+			table.store( t, std::memory_order_release );
+		}
+
+		// Keep load factor at or below 1/2, so that probe sequences stay short.
+		if ( 2 * ( num_entries.load( std::memory_order_relaxed ) + 1 ) > t->mask + 1 ) {
+
+			Table *grown = table_create( 2 * ( t->mask + 1 ) );
+
+			for ( size_t i = 0; i <= t->mask; i++ ) {
+				const uint64_t k = t->slots[ i ].key.load( std::memory_order_relaxed );
+				if ( k ) {
+					table_insert( grown, k, t->slots[ i ].value.load( std::memory_order_relaxed ) );
+				}
+			}
+
+			table.store( grown, std::memory_order_release );
+			retired_tables.push_back( t );
+			t = grown;
+		}
+
+		table_insert( t, key, value );
+		num_entries.fetch_add( 1, std::memory_order_release );
+	}
+};
+
+// ----------------------------------------------------------------------
+
+struct ApiEntry {
+	std::string name; // api name (used for debugging)
+	void *      ptr;  // pointer to struct holding api
+};
+
 struct ApiStore {
-	std::vector<std::string> names{};      // api names (used for debugging)
-	std::vector<uint64_t>    nameHashes{}; // Hashed api names (used for lookup)
-	std::vector<void *>      ptrs{};       // Pointer to struct holding api for each api name
+	std::vector<ApiEntry *> entries{}; // entries are allocated individually, so that they don't move when we add entries
+	HashTable               index{};   // hashed api name -> ApiEntry*
 	~ApiStore() {
 		// We must free any api table entry for which memory was been allocated.
-		for ( auto p : ptrs ) {
-			if ( p ) {
-				free( p );
+		for ( auto e : entries ) {
+			if ( e->ptr ) {
+				free( e->ptr );
 			}
+			delete e;
 		}
 	}
 };
@@ -65,48 +206,37 @@ struct DeferDelete {
 static DeferDelete defer_delete; // Any elements referenced in this pool will get deleted when program unloads.
 
 // ----------------------------------------------------------------------
-/// \returns index into apiStore entry for api with given id
+/// \returns apiStore entry for api with given id
 /// \param id        Hashed api name string
 /// \param debugName Api name string for debug purposes
-/// \note  In case a given id is not found in apiStore, a new entry is appended to apiStore
-static size_t produce_api_index( uint64_t id, const char *debugName ) {
+/// \note  In case a given id is not found in apiStore, a new entry is added to apiStore
+static ApiEntry *produce_api_entry( uint64_t id, const char *debugName ) {
 
-	size_t foundElement = 0;
+	ApiEntry *entry = static_cast<ApiEntry *>( apiStore.index.find( id ) );
 
-	for ( const auto &n : apiStore.nameHashes ) {
-		if ( n == id ) {
-			break;
-		}
-		++foundElement;
-	}
-
-	if ( foundElement == apiStore.nameHashes.size() ) {
+	if ( entry == nullptr ) {
 		// no element found, we need to add an element
-		apiStore.nameHashes.emplace_back( id );
-		apiStore.ptrs.emplace_back( nullptr );    // initialise to nullptr
-		apiStore.names.emplace_back( debugName ); // implicitly creates a string
+		entry = new ApiEntry{ debugName, nullptr }; // initialise api pointer to nullptr
+		apiStore.entries.push_back( entry );
+		apiStore.index.insert( id, entry );
 	}
 
-	// --------| invariant: foundElement points to correct element
+	// --------| invariant: entry points to correct element
 
-	return foundElement;
+	return entry;
 }
 
 // ----------------------------------------------------------------------
 
 static void *le_core_get_api( uint64_t id, const char *debugName ) {
-
-	size_t foundElement = produce_api_index( id, debugName );
-	return apiStore.ptrs[ foundElement ];
+	return produce_api_entry( id, debugName )->ptr;
 }
 
 // ----------------------------------------------------------------------
 
 static void *le_core_create_api( uint64_t id, size_t apiStructSize, const char *debugName ) {
 
-	size_t foundElement = produce_api_index( id, debugName );
-
-	auto &apiPtr = apiStore.ptrs[ foundElement ];
+	auto &apiPtr = produce_api_entry( id, debugName )->ptr;
 
 	if ( apiPtr == nullptr ) {
 
@@ -205,55 +335,63 @@ ISL_API_ATTR bool le_core_load_library_persistently( char const *library_name )
  * resolved at compile-time, therefore will not be
  * placed in table.
  * 
+ * With multithreaded recording, LE_ARGUMENT_NAME may be evaluated on several
+ * worker threads at once: lookups never lock, and since names are only ever
+ * added, most calls find their name already present. Only adding a new name
+ * takes the mutex, which serialises writers.
+ * 
  */
 struct ArgumentNameTable {
-	// std::mutex mtx; // TODO: consider: do we want to add a mutex so that any modifications to this table are protected when multithreading?
-	std::vector<std::string> names;
-	std::vector<uint64_t>    hashes;
+	std::mutex          mtx;   // protects `names`, and serialises inserts into `index`
+	std::vector<char *> names; // append-only log of names; names are allocated individually, so that they never move
+	HashTable           index; // argument name hash -> name c-string, owned by `names`
+	~ArgumentNameTable() {
+		for ( auto n : names ) {
+			free( n );
+		}
+	}
 };
 
 static ArgumentNameTable argument_names_table{};
 
 ISL_API_ATTR void le_update_argument_name_table( const char *name, uint64_t value ) {
 
-	// find index of entry with current value in table
+	// find entry with current value in table
 
-	uint64_t const *hashes_begin = argument_names_table.hashes.data();
-	auto            hashes_end   = hashes_begin + argument_names_table.hashes.size();
+	char const *found_name = static_cast<char const *>( argument_names_table.index.find( value ) );
 
-	size_t name_index = 0;
-	for ( auto h = hashes_begin; h != hashes_end; h++, name_index++ ) {
-		if ( *h == value ) {
-			break;
+	if ( found_name == nullptr ) {
+
+		std::scoped_lock lock( argument_names_table.mtx );
+
+		// Another thread might have added this name since we looked.
+		found_name = static_cast<char const *>( argument_names_table.index.find( value ) );
+
+		if ( found_name == nullptr ) {
+			// not found, we must add a new entry
+			argument_names_table.names.push_back( strdup( name ) );
+			argument_names_table.index.insert( value, argument_names_table.names.back() );
+			// std::cout << "Argument: '" << std::setw( 30 ) << source << "' : 0x" << std::hex << value << std::endl
+			//           << std::flush;
+			return;
 		}
 	}
 
-	if ( name_index == argument_names_table.names.size() ) {
-		// not found, we must add a new entry
-		argument_names_table.names.push_back( name );
-		argument_names_table.hashes.push_back( value );
-		// std::cout << "Argument: '" << std::setw( 30 ) << source << "' : 0x" << std::hex << value << std::endl
-		//           << std::flush;
-	} else {
-		// entry already exists - test whether the names match
-		assert( argument_names_table.names.at( name_index ) == std::string( name ) && "Possible hash collision, names for hashes don't match!" );
-	}
+	// --------| invariant: entry already exists - test whether the names match
+
+	assert( std::string( found_name ) == name && "Possible hash collision, names for hashes don't match!" );
 };
 
 ISL_API_ATTR char const *le_get_argument_name_from_hash( uint64_t value ) {
 
-	if ( argument_names_table.hashes.empty() ) {
+	if ( argument_names_table.index.size() == 0 ) {
 		return "<< Argument name table empty. >>";
 	}
 
-	uint64_t const *hashes_begin = argument_names_table.hashes.data();
-	auto            hashes_end   = hashes_begin + argument_names_table.hashes.size();
+	char const *found_name = static_cast<char const *>( argument_names_table.index.find( value ) );
 
-	size_t name_index = 0;
-	for ( auto h = hashes_begin; h != hashes_end; h++, name_index++ ) {
-		if ( *h == value ) {
-			return argument_names_table.names.at( name_index ).c_str();
-		}
+	if ( found_name ) {
+		return found_name;
 	}
 
 	return "<< Argument name could not be resolved. >>";
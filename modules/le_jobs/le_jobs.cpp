@@ -2,14 +2,34 @@
 #include "le_core/le_core.h"
 
 #include <atomic>
-#include <mutex>
-#include <forward_list>
-#include <list>
 #include <cstdlib> // for malloc
 #include <thread>
+#include <vector>
+#include <climits>
+#include <cstdio>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 #include "assert.h"
 
-#include "private/lockfree_ring_buffer.h"
+#include "private/lockfree_mpmc_queue.h"
+#include "private/work_stealing_deque.h"
+#include "private/cpu_topology.h"
+
+#ifndef LE_JOBS_TRACE
+#	define LE_JOBS_TRACE 0 // (no-hotreload) set to 1 to record job system events, which you may then write out via `write_trace`
+#endif
+
+#if ( LE_JOBS_TRACE > 0 )
+#	include "private/job_trace.h"
+#	include <chrono>
+#	include <cstdio>
+#	define LE_JOBS_TRACE_RECORD( ring_index, event_type, id, fiber_idx ) \
+		job_trace_ring_record( trace_rings[ ring_index ], JobTraceEvent::event_type, uint64_t( id ), uint32_t( fiber_idx ) )
+#else
+#	define LE_JOBS_TRACE_RECORD( ring_index, event_type, id, fiber_idx )
+#endif
 
 struct le_fiber_o;
 struct le_worker_thread_o;
@@ -18,13 +38,31 @@ extern "C" void asm_call_fiber_exit( void );
 extern "C" int  asm_switch( le_fiber_o *to, le_fiber_o *from, int switch_to_guest );
 extern "C" void asm_fetch_default_control_words( uint64_t * );
 
+/* A counter packs the number of outstanding jobs (lower 32 bits) together with
+ * a tag identifying who is waiting for the counter (upper 32 bits) into one
+ * atomic word.
+ *
+ * This means that whoever decrements the counter learns - with the same atomic
+ * operation - whether there is a waiter which must be woken up. This matters,
+ * because the waiter is free to delete the counter as soon as it observes that
+ * the counter has reached zero: the decrementing thread must therefore not
+ * touch the counter after its decrement.
+ */
 struct le_jobs_api::counter_t {
-	std::atomic<uint32_t> data{ 0 };
+	std::atomic<uint64_t> data{ 0 };
+	std::atomic<uint32_t> pool_next{ 0 }; // index of next free counter while this counter sits in the counter pool's free list
 };
 
+constexpr static uint64_t COUNTER_VALUE_MASK      = 0xffffffffull;
+constexpr static uint32_t COUNTER_WAITER_NONE     = 0; // nobody is waiting for this counter (yet)
+constexpr static uint32_t COUNTER_WAITER_EXTERNAL = 1; // a thread outside the job system is parked, waiting for this counter
+constexpr static uint32_t COUNTER_WAITER_WORKER_0 = 2; // a fiber on worker thread (tag - COUNTER_WAITER_WORKER_0) waits for this counter
+
 using counter_t = le_jobs_api::counter_t;
 using le_job_o  = le_jobs_api::le_job_o;
 
+static_assert( sizeof( le_job_o ) % 8 == 0, "jobs are stored in-place in job queues, which requires their size to be a multiple of 8 bytes" );
+
 /* NOTE - consider appropriate stack size.
  * 
  * Make sure to set the per-fiber stack size to a value large enough, or jobs will write
@@ -38,16 +76,29 @@ using le_job_o  = le_jobs_api::le_job_o;
  * potentially large size, memory overcommitting makes sure that physical memory only gets 
  * allocated if you really need it.
  *
+ * Each fiber stack is followed (at its lower end, as stacks grow downwards) by a guard page 
+ * which may not be read or written to: a stack overflow will therefore trigger a segfault 
+ * as soon as it happens, instead of silently corrupting memory.
+ *
  */
 
-constexpr static size_t FIBER_POOL_SIZE         = 128;     // Number of available fibers, each with their own stack
-constexpr static size_t FIBER_STACK_SIZE        = 1 << 23; // 2^23 == 8 MB
-constexpr static size_t MAX_WORKER_THREAD_COUNT = 16;      // Maximum number of possible, but not necessarily requested worker threads.
-
-enum class FIBER_STATUS : uint64_t {
-	eIdle       = 0,
-	eProcessing = 1,
-};
+constexpr static size_t   DEFAULT_FIBER_POOL_SIZE        = 128;     // Number of available fibers, each with their own stack, unless specified otherwise via initialize()
+constexpr static size_t   FIBER_STACK_SIZE               = 1 << 23; // 2^23 == 8 MB
+constexpr static size_t   MAX_WORKER_THREAD_COUNT        = 16;      // Maximum number of possible, but not necessarily requested worker threads.
+constexpr static size_t   WORKER_QUEUE_SIZE_POT          = 10;      // Per-worker job deque capacity, as a power of 2, so "10" means 1024 elements
+constexpr static size_t   INJECTOR_QUEUE_SIZE_POT        = 16;      // Injector queue capacity, as a power of 2 - holds tens of thousands of tiny jobs per frame
+constexpr static size_t   PINNED_QUEUE_SIZE_POT          = 10;      // Capacity of queues for pinned jobs, per worker, and for threads outside the job system, as a power of 2
+constexpr static size_t   JOB_PRIORITY_COUNT             = 3;       // Number of LeJobPriority levels; each level has its own set of job queues
+constexpr static size_t   COUNTER_POOL_SIZE              = 4096;    // Number of pooled counters; if the pool runs dry, counters are allocated on the heap
+constexpr static uint32_t PARALLEL_FOR_MAX_CHUNKS        = 256;     // Upper limit for number of sub-ranges for parallel_for; grain size is increased if needed
+constexpr static uint32_t PARALLEL_FOR_CHUNKS_PER_WORKER = 4;       // Number of sub-ranges per worker thread if no grain size was given
+constexpr static uint32_t WORKER_SPIN_COUNT_MIN          = 16;      // Lower bound for the number of empty dispatch rounds before an idle worker parks
+constexpr static uint32_t WORKER_SPIN_COUNT_MAX          = 4096;    // Upper bound for the number of empty dispatch rounds before an idle worker parks
+constexpr static uint32_t WAITER_SPIN_COUNT              = 1024;    // Number of polls before a thread outside the job system parks on a counter
+constexpr static uint32_t POOL_INDEX_NONE                = ~uint32_t( 0 );
+constexpr static uint32_t CPU_NONE                       = ~uint32_t( 0 );
+constexpr static int32_t  AFFINITY_EXTERNAL              = -3;      // internal: job is pinned to threads outside the job system
+constexpr static uint32_t TRACE_RING_SIZE_POT            = 16;      // Number of events per trace ring, as a power of 2, so "16" means 65536 events
 
 /* A Fiber is an execution context, in which a job can execute.
  * For this it provides the job with a stack.
@@ -64,26 +115,36 @@ enum class FIBER_STATUS : uint64_t {
  * 
  */
 struct le_fiber_o {
-	void **                   stack                = nullptr;             // pointer to address of current stack
-	void *                    job_param            = nullptr;             // parameter pointer for job
-	void *                    stack_bottom         = nullptr;             // allocation address so that it may be freed
-	counter_t *               fiber_await_counter  = nullptr;             // owned by le_job_manager, must be nullptr, or counter->data must be zero for fiber to start/resume
-	counter_t *               job_complete_counter = nullptr;             // owned by le_job_manager
-	uint64_t                  job_complete         = 0;                   // flag whether job was completed.
-	std::atomic<FIBER_STATUS> fiber_status         = FIBER_STATUS::eIdle; // flag whether fiber is currently active
-	le_fiber_o *              list_prev            = nullptr;             // intrusive list
-	le_fiber_o *              list_next            = nullptr;             // intrusive list
-	constexpr static size_t   NUM_REGISTERS        = 6;                   // must save RBX, RBP, and R12..R15
+	void **                 stack                = nullptr; // pointer to address of current stack
+	void *                  job_param            = nullptr; // parameter pointer for job
+	void *                  stack_bottom         = nullptr; // lowest usable stack address, just above guard page
+	le_jobs_api::fun_ptr_t  job_fun_ptr          = nullptr; // function for current job, for diagnostics
+	counter_t *             fiber_await_counter  = nullptr; // owned by le_job_manager, must be nullptr, or counter->data must be zero for fiber to start/resume
+	counter_t *             job_complete_counter = nullptr; // owned by le_job_manager
+	uint64_t                job_complete         = 0;       // flag whether job was completed.
+	le_fiber_o *            list_prev            = nullptr; // intrusive list
+	le_fiber_o *            list_next            = nullptr; // intrusive list
+	void *                  stack_mapping        = nullptr; // address of stack memory mapping (including guard page), so that it may be unmapped
+	size_t                  stack_mapping_size   = 0;       // size of stack memory mapping, in bytes
+	std::atomic<uint32_t>   pool_next{ 0 };                 // index of next idle fiber while this fiber sits in the fiber pool's free list
+	constexpr static size_t NUM_REGISTERS = 6;              // must save RBX, RBP, and R12..R15
 };
 
 struct le_job_manager_o {
-	std::mutex                     counters_mtx;                // mutex protecting counters list
-	std::forward_list<counter_t *> counters;                    // storage for counters, list.
-	le_fiber_o *                   fibers[ FIBER_POOL_SIZE ]{}; // pool of available fibers
-	lockfree_ring_buffer_t *       job_queue;                   // queue onto which to push jobs
-	size_t                         worker_thread_count = 0;     // actual number of initialised worker threads
+	counter_t              counters[ COUNTER_POOL_SIZE ];             // pool of counters
+	std::atomic<uint64_t>  counters_free_list{ 0 };                   // head of counter free list: lower 32 bits: index of first free counter, upper 32 bits: ABA tag
+	le_fiber_o *           fibers      = nullptr;                     // pool of fibers
+	uint32_t               fiber_count = 0;                           // number of fibers in fiber pool
+	std::atomic<uint64_t>  fibers_free_list{ 0 };                     // head of idle fiber free list: lower 32 bits: index of first idle fiber, upper 32 bits: ABA tag
+	lockfree_mpmc_queue_t *injector_queues[ JOB_PRIORITY_COUNT ]{};   // per priority: queue onto which to push jobs issued from outside the job system
+	lockfree_mpmc_queue_t *external_pinned_queue = nullptr;           // jobs pinned to threads outside the job system; drained while these threads wait for counters
+	std::atomic<uint32_t>  external_park_word{ 0 };                   // futex word for threads outside the job system; bumped by whoever wants to wake them
+	size_t                 worker_thread_count = 0;                   // actual number of initialised worker threads
+	std::atomic<uint64_t>  parked_workers{ 0 };                       // bitfield: bit `i` is set if worker thread `i` is parked, or about to park
 };
 
+static_assert( MAX_WORKER_THREAD_COUNT <= 64, "parked_workers bitfield must be able to hold a bit for each worker thread" );
+
 struct le_fiber_list_t {
 	le_fiber_o *begin = nullptr;
 	le_fiber_o *end   = nullptr;
@@ -99,22 +160,158 @@ struct le_fiber_list_t {
  * it is put on the worker thread's wait_list. If a fiber is ready to 
  * resume, it is taken from the wait_list and put on the ready_list. 
  * 
+ * Each worker thread owns a job deque per job priority. Jobs issued from
+ * within a fiber running on this worker thread are pushed onto the deque
+ * matching their priority. Jobs pinned to a worker thread go onto this
+ * worker thread's pinned queue for their priority, from where no other
+ * worker thread may take them.
+ * 
  */
 struct le_worker_thread_o {
-	le_fiber_o      host_fiber{};          // Host context which does the switching
-	le_fiber_o *    guest_fiber = nullptr; // current fiber executing inside this worker thread
-	std::thread     thread      = {};      //
-	std::thread::id thread_id   = {};      //
-	le_fiber_list_t wait_list   = {};      // list of fibers which need checking their condition
-	le_fiber_list_t ready_list  = {};      // list of fibers ready to resume after yield
-	uint64_t        stop_thread = 0;       // flag, value `1` tells worker to join
+	le_fiber_o             host_fiber{};          // Host context which does the switching
+	le_fiber_o *           guest_fiber = nullptr; // current fiber executing inside this worker thread
+	std::thread            thread      = {};      //
+	std::thread::id        thread_id   = {};      //
+	le_fiber_list_t        wait_list   = {};      // list of fibers which need checking their condition
+	le_fiber_list_t        ready_list  = {};      // list of fibers ready to resume after yield
+	work_stealing_deque_t *job_queues[ JOB_PRIORITY_COUNT ]{};         // per priority: jobs issued from fibers running on this worker; other workers may steal from here
+	lockfree_mpmc_queue_t *pinned_queues[ JOB_PRIORITY_COUNT ]{};      // per priority: jobs which may only run on this worker
+	uint32_t               worker_idx = 0;                             // index of this worker in static_worker_threads
+	uint32_t               spin_count = 0;                             // adaptive number of empty dispatch rounds before this worker parks
+	uint64_t               rand_state = 0;                             // state for victim selection when stealing, must not be 0
+	uint32_t               cpu        = CPU_NONE;                      // logical cpu this worker is pinned to, CPU_NONE if not pinned
+	uint32_t               steal_victims[ MAX_WORKER_THREAD_COUNT ]{}; // other workers, those sharing our socket first
+	uint32_t               steal_victims_count = 0;                    // number of valid entries in steal_victims
+	uint32_t               steal_victims_near  = 0;                    // number of entries in steal_victims which share our socket
+	std::atomic<uint32_t>  park_word{ 0 };                             // futex word; bumped by whoever wants to wake this worker
+	std::atomic<uint64_t>  stop_thread{ 0 };                           // flag, value `1` tells worker to join
 };
 
 static le_worker_thread_o *static_worker_threads[ MAX_WORKER_THREAD_COUNT ]{};
 static le_job_manager_o *  job_manager = nullptr; ///< job manager singleton, must be initialised via initialise(), and terminated via terminate().
+static LeJobsPlacement     worker_placement = LeJobsPlacement::ePhysicalCores; // placement policy for worker threads, applied by initialise()
 
 static uint64_t DEFAULT_CONTROL_WORDS = 0; // storage for default control words (must be 8 byte, == 2 words)
 
+#if ( LE_JOBS_TRACE > 0 )
+// One trace ring per worker thread, plus one ring - at index MAX_WORKER_THREAD_COUNT - shared
+// by all threads outside the job system.
+constexpr static size_t TRACE_RING_EXTERNAL = MAX_WORKER_THREAD_COUNT;
+
+static job_trace_ring_t *trace_rings[ MAX_WORKER_THREAD_COUNT + 1 ]{};
+static uint64_t          trace_tsc_origin             = 0;
+static uint64_t          trace_steady_clock_origin_ns = 0;
+#endif
+
+// ----------------------------------------------------------------------
+
+static inline void cpu_relax() {
+	__builtin_ia32_pause();
+}
+
+// ----------------------------------------------------------------------
+// Block calling thread for as long as `*addr == expected_value`.
+// May return spuriously - callers must re-check their condition.
+static inline void futex_wait( void *addr, uint32_t expected_value ) {
+	syscall( SYS_futex, addr, FUTEX_WAIT_PRIVATE, expected_value, nullptr, nullptr, 0 );
+}
+
+// ----------------------------------------------------------------------
+// Wake up to `num_waiters` threads blocked on `addr`.
+//
+// Note that this does not dereference `addr`, which means that it is safe to
+// call this with the address of an object which might have just been freed.
+static inline void futex_wake( void *addr, int num_waiters ) {
+	syscall( SYS_futex, addr, FUTEX_WAKE_PRIVATE, num_waiters, nullptr, nullptr, 0 );
+}
+
+// ----------------------------------------------------------------------
+
+static inline uint32_t counter_get_value( counter_t const *counter ) {
+	return uint32_t( counter->data.load() & COUNTER_VALUE_MASK );
+}
+
+// ----------------------------------------------------------------------
+// Pools (of counters, of fibers) keep their idle elements in a free list, which
+// is a lock-free stack of element indices. Each element stores the index of the
+// next idle element in its `pool_next` field.
+//
+// The head of the free list carries a tag (upper 32 bits) which is incremented
+// with every change, so that a stale head can't win the CAS (ABA problem).
+//
+// Returns index of the popped element, or POOL_INDEX_NONE if the pool is empty.
+template <typename T>
+static uint32_t pool_free_list_pop( std::atomic<uint64_t> &free_list, T *elements ) {
+
+	uint64_t head = free_list.load( std::memory_order_acquire );
+
+	for ( ;; ) {
+		const uint32_t index = uint32_t( head );
+
+		if ( index == POOL_INDEX_NONE ) {
+			return POOL_INDEX_NONE;
+		}
+
+		const uint32_t next     = elements[ index ].pool_next.load( std::memory_order_relaxed );
+		const uint64_t new_head = ( ( ( head >> 32 ) + 1 ) << 32 ) | next;
+
+		if ( free_list.compare_exchange_weak( head, new_head, std::memory_order_acquire ) ) {
+			return index;
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+// Push element with given index onto free list.
+// Returns true if the free list was empty before the push.
+template <typename T>
+static bool pool_free_list_push( std::atomic<uint64_t> &free_list, T *elements, uint32_t index ) {
+
+	uint64_t head = free_list.load( std::memory_order_relaxed );
+	uint64_t new_head;
+
+	do {
+		elements[ index ].pool_next.store( uint32_t( head ), std::memory_order_relaxed );
+		new_head = ( ( ( head >> 32 ) + 1 ) << 32 ) | index;
+	} while ( !free_list.compare_exchange_weak( head, new_head, std::memory_order_release, std::memory_order_relaxed ) );
+
+	return uint32_t( head ) == POOL_INDEX_NONE;
+}
+
+// ----------------------------------------------------------------------
+// Chain all counters in the counter pool into the pool's free list.
+static void counter_pool_initialize( le_job_manager_o *manager ) {
+	for ( uint32_t i = 0; i != COUNTER_POOL_SIZE; ++i ) {
+		manager->counters[ i ].pool_next = ( i + 1 == COUNTER_POOL_SIZE ) ? POOL_INDEX_NONE : i + 1;
+	}
+	manager->counters_free_list = 0;
+}
+
+// ----------------------------------------------------------------------
+// Take a counter from the counter pool, and set its value.
+//
+// Should the pool run dry, we fall back to allocating a counter on the heap.
+static counter_t *counter_acquire( uint32_t value ) {
+
+	const uint32_t index   = pool_free_list_pop( job_manager->counters_free_list, job_manager->counters );
+	counter_t *    counter = ( index == POOL_INDEX_NONE ) ? new counter_t() : &job_manager->counters[ index ];
+
+	counter->data = value; // Note this also resets the waiter tag
+	return counter;
+}
+
+// ----------------------------------------------------------------------
+// Return a counter to the counter pool, or free it if it was heap-allocated.
+static void counter_release( counter_t *counter ) {
+
+	if ( counter < job_manager->counters || counter >= job_manager->counters + COUNTER_POOL_SIZE ) {
+		delete counter;
+		return;
+	}
+
+	pool_free_list_push( job_manager->counters_free_list, job_manager->counters, uint32_t( counter - job_manager->counters ) );
+}
+
 // ----------------------------------------------------------------------
 void fiber_list_push_back( le_fiber_list_t *list, le_fiber_o *element ) {
 
@@ -174,27 +371,45 @@ void fiber_list_remove_element( le_fiber_list_t *list, le_fiber_o *element ) {
 }
 
 // ----------------------------------------------------------------------
-// Creates a fiber object, and allocates memory for this fiber
-static le_fiber_o *le_fiber_create() {
+// Allocates stack memory for a fiber, with a guard page below the stack.
+// Returns false if stack memory could not be allocated.
+static bool le_fiber_create_stack( le_fiber_o *fiber ) {
 
-	le_fiber_o *fiber = new le_fiber_o();
-
-	/* Create a 16-byte aligned stack */
+	/* Create a 16-byte aligned stack - memory mappings are page-aligned */
 	static_assert( FIBER_STACK_SIZE % 16 == 0, "stack size must be 16 byte-aligned." );
 
-	fiber->stack_bottom = malloc( FIBER_STACK_SIZE );
+	const size_t page_size = size_t( sysconf( _SC_PAGESIZE ) );
+
+	assert( FIBER_STACK_SIZE % page_size == 0 && "stack size must be a multiple of page size" );
 
-	if ( fiber->stack_bottom == nullptr )
-		return nullptr;
+	fiber->stack_mapping_size = FIBER_STACK_SIZE + page_size;
+	fiber->stack_mapping      = mmap( nullptr, fiber->stack_mapping_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_STACK, -1, 0 );
 
-	return fiber;
+	if ( fiber->stack_mapping == MAP_FAILED ) {
+		fiber->stack_mapping = nullptr;
+		return false;
+	}
+
+	// Stacks grow downwards - the guard page must therefore sit at the lowest address.
+	if ( 0 != mprotect( fiber->stack_mapping, page_size, PROT_NONE ) ) {
+		munmap( fiber->stack_mapping, fiber->stack_mapping_size );
+		fiber->stack_mapping = nullptr;
+		return false;
+	}
+
+	fiber->stack_bottom = static_cast<char *>( fiber->stack_mapping ) + page_size;
+
+	return true;
 }
 
 // ----------------------------------------------------------------------
 
-static void le_fiber_destroy( le_fiber_o *fiber ) {
-	free( fiber->stack_bottom );
-	delete ( fiber );
+static void le_fiber_destroy_stack( le_fiber_o *fiber ) {
+	if ( fiber->stack_mapping ) {
+		munmap( fiber->stack_mapping, fiber->stack_mapping_size );
+	}
+	fiber->stack_mapping = nullptr;
+	fiber->stack_bottom  = nullptr;
 }
 
 // ----------------------------------------------------------------------
@@ -226,6 +441,7 @@ static void le_fiber_load_job( le_fiber_o *fiber, le_fiber_o *host_fiber, le_job
 	*( --fiber->stack ) = reinterpret_cast<void *>( DEFAULT_CONTROL_WORDS );
 
 	fiber->job_param            = job->fun_param;
+	fiber->job_fun_ptr          = job->fun_ptr;
 	fiber->job_complete         = 0;
 	fiber->job_complete_counter = job->complete_counter;
 	fiber->fiber_await_counter  = nullptr;
@@ -255,6 +471,76 @@ static le_worker_thread_o *get_current_thread() {
 	return ( worker_thread_id == -1 ) ? nullptr : static_worker_threads[ worker_thread_id ];
 }
 
+// ----------------------------------------------------------------------
+// Wake up a worker thread if it is parked; if the worker thread is about
+// to park, this will prevent it from going to sleep.
+static void le_worker_thread_unpark( le_worker_thread_o *worker ) {
+	worker->park_word.fetch_add( 1 );
+	if ( job_manager->parked_workers.load() & ( uint64_t( 1 ) << worker->worker_idx ) ) {
+		futex_wake( &worker->park_word, 1 );
+	}
+}
+
+// ----------------------------------------------------------------------
+// Wake up to `num_workers` parked worker threads, so that they can
+// pick up newly issued jobs.
+static void le_job_manager_unpark_workers( uint32_t num_workers ) {
+
+	// Make sure that any jobs which were just pushed are visible to
+	// workers which we don't see as parked (and which will therefore
+	// re-check the job queues before they go to sleep).
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+
+	for ( ; num_workers != 0; --num_workers ) {
+		uint64_t parked = job_manager->parked_workers.load();
+		uint64_t bit;
+		do {
+			if ( 0 == parked ) {
+				return;
+			}
+			bit = parked & ( ~parked + 1 ); // lowest set bit
+		} while ( !job_manager->parked_workers.compare_exchange_weak( parked, parked & ~bit ) );
+
+		// --------| invariant: we claimed worker at bit, it won't be woken by anyone else.
+
+		le_worker_thread_o *worker = static_worker_threads[ __builtin_ctzll( bit ) ];
+		worker->park_word.fetch_add( 1 );
+		futex_wake( &worker->park_word, 1 );
+	}
+}
+
+// ----------------------------------------------------------------------
+// Wake up all threads outside the job system which are parked in
+// wait_for_counter_and_free, so that they re-check their counter, and
+// pick up any jobs which were pinned to them.
+static void le_job_manager_unpark_external_threads() {
+	job_manager->external_park_word.fetch_add( 1 );
+	futex_wake( &job_manager->external_park_word, INT_MAX );
+}
+
+// ----------------------------------------------------------------------
+// Decrement counter, and wake up whoever might be waiting for the
+// counter to reach zero.
+//
+// Note that we must not access counter after the decrement: once the
+// counter reaches zero, its waiter is allowed to free it.
+static void counter_decrement( counter_t *counter ) {
+
+	const uint64_t previous = counter->data.fetch_sub( 1 );
+	const uint32_t value    = uint32_t( previous & COUNTER_VALUE_MASK ) - 1;
+	const uint32_t waiter   = uint32_t( previous >> 32 );
+
+	if ( value != 0 || waiter == COUNTER_WAITER_NONE ) {
+		return;
+	}
+
+	if ( waiter == COUNTER_WAITER_EXTERNAL ) {
+		le_job_manager_unpark_external_threads();
+	} else {
+		le_worker_thread_unpark( static_worker_threads[ waiter - COUNTER_WAITER_WORKER_0 ] );
+	}
+}
+
 // ----------------------------------------------------------------------
 // Fiber yield means that the fiber needs to go to sleep and that control needs to return to
 // the worker_thread.
@@ -284,7 +570,7 @@ static void le_fiber_yield() {
 extern "C" void __attribute__( ( __noreturn__ ) ) fiber_exit( le_fiber_o *host_fiber, le_fiber_o *guest_fiber ) {
 
 	if ( guest_fiber->job_complete_counter ) {
-		--guest_fiber->job_complete_counter->data;
+		counter_decrement( guest_fiber->job_complete_counter );
 	}
 
 	guest_fiber->job_complete = 1;
@@ -297,8 +583,126 @@ extern "C" void __attribute__( ( __noreturn__ ) ) fiber_exit( le_fiber_o *host_f
 }
 
 // ----------------------------------------------------------------------
+// xorshift64 - cheap pseudo-random numbers for picking a victim to steal from.
+static inline uint64_t le_worker_thread_next_random( le_worker_thread_o *self ) {
+	uint64_t x = self->rand_state;
+	x ^= x << 13;
+	x ^= x >> 7;
+	x ^= x << 17;
+	return self->rand_state = x;
+}
+
+// ----------------------------------------------------------------------
+// Try to steal a job of priority `p` from victims [begin, end) in this worker's
+// list of steal victims, starting with a random victim in that range.
+static bool le_worker_thread_steal( le_worker_thread_o *self, uint32_t begin, uint32_t end, size_t p, le_job_o *job ) {
+
+	const uint32_t count = end - begin;
+
+	if ( count == 0 ) {
+		return false;
+	}
+
+	uint32_t offset = uint32_t( le_worker_thread_next_random( self ) % count );
 
-static void le_worker_thread_dispatch( le_worker_thread_o *self ) {
+	for ( uint32_t i = 0; i != count; ++i, offset = ( offset + 1 ) % count ) {
+		if ( work_stealing_deque_steal( static_worker_threads[ self->steal_victims[ begin + offset ] ]->job_queues[ p ], job ) ) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// ----------------------------------------------------------------------
+// Find the next job for this worker thread to execute.
+//
+// Priorities are drained strictly: we only look at queues for a priority
+// once all queues for higher priorities have come up empty. Within each
+// priority, in order of preference:
+//
+// 1. Pop oldest job pinned to this worker thread
+// 2. Pop most recently issued job from own deque (best cache locality)
+// 3. Pop oldest job from injector queue (jobs issued from outside job system)
+// 4. Steal oldest job from another worker thread - first from workers which
+//    share our socket, then from all others, starting with a random victim
+//
+// Returns false if no job could be found, otherwise copies job into `job`.
+static bool le_worker_thread_fetch_job( le_worker_thread_o *self, le_job_o *job ) {
+
+	for ( size_t p = 0; p != JOB_PRIORITY_COUNT; ++p ) {
+
+		if ( lockfree_mpmc_queue_trypop( self->pinned_queues[ p ], job ) ) {
+			return true;
+		}
+
+		if ( work_stealing_deque_pop( self->job_queues[ p ], job ) ) {
+			return true;
+		}
+
+		if ( lockfree_mpmc_queue_trypop( job_manager->injector_queues[ p ], job ) ) {
+			return true;
+		}
+
+		if ( le_worker_thread_steal( self, 0, self->steal_victims_near, p, job ) ||
+		     le_worker_thread_steal( self, self->steal_victims_near, self->steal_victims_count, p, job ) ) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// ----------------------------------------------------------------------
+// Take an idle fiber from the fiber pool - returns nullptr if all fibers are in use.
+static le_fiber_o *le_fiber_pool_acquire() {
+	const uint32_t index = pool_free_list_pop( job_manager->fibers_free_list, job_manager->fibers );
+	return ( index == POOL_INDEX_NONE ) ? nullptr : &job_manager->fibers[ index ];
+}
+
+// ----------------------------------------------------------------------
+// Wake up all parked worker threads which have jobs pinned to them. Only these
+// workers may execute their pinned jobs - waking any other worker won't help.
+static void le_job_manager_unpark_workers_with_pinned_jobs() {
+
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+
+	for ( uint64_t parked = job_manager->parked_workers.load(); parked != 0; parked &= parked - 1 ) {
+
+		le_worker_thread_o *worker = static_worker_threads[ __builtin_ctzll( parked ) ];
+
+		for ( size_t p = 0; p != JOB_PRIORITY_COUNT; ++p ) {
+			if ( lockfree_mpmc_queue_size( worker->pinned_queues[ p ] ) ) {
+				le_worker_thread_unpark( worker );
+				break;
+			}
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+// Return a fiber to the fiber pool. If `has_completed_job` is false, the fiber
+// is returned unused, because no job could be found for it.
+static void le_fiber_pool_release( le_fiber_o *fiber, bool has_completed_job = true ) {
+	if ( pool_free_list_push( job_manager->fibers_free_list, job_manager->fibers, uint32_t( fiber - job_manager->fibers ) ) ) {
+		// The pool had run dry - other workers might have parked because they had
+		// no fiber to execute pending jobs with.
+		//
+		// Workers with pinned jobs can't rely on anyone else to run these jobs, so we
+		// must wake all of them. If we just completed a job, we also wake one other
+		// worker, which may pick up any unpinned jobs. We don't do this for a fiber
+		// which is returned unused, as the woken worker would find no job either.
+		le_job_manager_unpark_workers_with_pinned_jobs();
+		if ( has_completed_job ) {
+			le_job_manager_unpark_workers( 1 );
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+
+// Returns true if any fiber was executed, false if there was no work available.
+static bool le_worker_thread_dispatch( le_worker_thread_o *self ) {
 
 	// -- Check all fibers on the wait list, and add them to the ready list
 	// should their condition have become true.
@@ -308,7 +712,7 @@ static void le_worker_thread_dispatch( le_worker_thread_o *self ) {
 		le_fiber_o *f = it_f;            // We must capture f here,
 		it_f          = it_f->list_next; // and increase iterator, since it_f may be invalidated because of remove op
 
-		if ( nullptr == f->fiber_await_counter || 0 == f->fiber_await_counter->data ) {
+		if ( nullptr == f->fiber_await_counter || 0 == counter_get_value( f->fiber_await_counter ) ) {
 			fiber_list_remove_element( &self->wait_list, f ); // Must first remove, since list op is intrusive and will update the fiber
 			fiber_list_push_back( &self->ready_list, f );     // This will also update the fiber
 		}
@@ -319,48 +723,37 @@ static void le_worker_thread_dispatch( le_worker_thread_o *self ) {
 	if ( self->ready_list.begin ) {
 		self->guest_fiber = self->ready_list.begin;
 		fiber_list_remove_element( &self->ready_list, self->ready_list.begin );
+		LE_JOBS_TRACE_RECORD( self->worker_idx, eFiberResume, self->guest_fiber->job_fun_ptr, self->guest_fiber - job_manager->fibers );
 	}
 
 	if ( nullptr == self->guest_fiber ) {
 
-		// find first available idle fiber
-		size_t i = 0;
-		for ( i = 0; i != FIBER_POOL_SIZE; ++i ) {
-			auto fib_idle = FIBER_STATUS::eIdle; // < value to compare against
+		// take an idle fiber from the fiber pool
+		self->guest_fiber = le_fiber_pool_acquire();
 
-			if ( job_manager->fibers[ i ]->fiber_status.compare_exchange_weak( fib_idle, FIBER_STATUS::eProcessing ) ) {
-				// ----------| invariant: `fiber_active` was 0, is now atomically changed to 1
-				self->guest_fiber = job_manager->fibers[ i ];
-				break;
-			}
-		}
-
-		if ( i == FIBER_POOL_SIZE ) {
+		if ( nullptr == self->guest_fiber ) {
 			// we could not find an available fiber, we must return empty-handed.
-			return;
+			return false;
 		}
 
-		// Pop the job which has been waiting the longest off the job queue
+		// Fetch the next job of highest available priority - either from our pinned queues,
+		// our own deques, the injector queues, or by stealing.
 
-		le_job_o *job = static_cast<le_job_o *>( lockfree_ring_buffer_trypop( job_manager->job_queue ) );
+		le_job_o job;
 
-		if ( nullptr == job ) {
-			// We couldn't get another job from the queue - this could mean that the queue is empty.
-			// anyway, let's wait a little bit before returning...
+		if ( false == le_worker_thread_fetch_job( self, &job ) ) {
+			// We couldn't get another job from any queue - this could mean that all queues are empty.
+			// Our caller decides whether to spin, or to park this worker thread.
 
-			self->guest_fiber->fiber_status = FIBER_STATUS::eIdle; // return fiber to pool
-			self->guest_fiber               = nullptr;
+			// Return fiber to pool - this may still need to wake workers which have jobs pinned to them.
+			le_fiber_pool_release( self->guest_fiber, false );
+			self->guest_fiber = nullptr;
 
-			std::this_thread::sleep_for( std::chrono::nanoseconds( 100 ) );
-			return;
+			return false;
 		} else {
 
-			le_fiber_load_job( self->guest_fiber, &self->host_fiber, job );
-
-			// we don't need job anymore after it was passed to fiber_setup
-			// and since the ring buffer did own the job, we must delete it
-			// here.
-			delete ( job );
+			le_fiber_load_job( self->guest_fiber, &self->host_fiber, &job );
+			LE_JOBS_TRACE_RECORD( self->worker_idx, eJobBegin, job.fun_ptr, self->guest_fiber - job_manager->fibers );
 		}
 	}
 
@@ -370,11 +763,11 @@ static void le_worker_thread_dispatch( le_worker_thread_o *self ) {
 	// or unset. Otherwise this means that child jobs of a fiber are still
 	// executing.
 
-	if ( self->guest_fiber->fiber_await_counter && self->guest_fiber->fiber_await_counter->data != 0 ) {
+	if ( self->guest_fiber->fiber_await_counter && counter_get_value( self->guest_fiber->fiber_await_counter ) != 0 ) {
 		// This fiber is not ready yet, as its dependent jobs are still executing.
 		// we must not process it further, instead place this fiber on the wait list.
 		assert( false );
-		return;
+		return false;
 	}
 
 	assert( self->guest_fiber->stack ); // address of stack must not be 0
@@ -390,31 +783,183 @@ static void le_worker_thread_dispatch( le_worker_thread_o *self ) {
 
 	if ( 1 == self->guest_fiber->job_complete ) {
 		// Fiber was completed: We must return it to the pool
-		self->guest_fiber->stack        = nullptr;             // Reset fiber stack
-		self->guest_fiber->fiber_status = FIBER_STATUS::eIdle; // return fiber to pool !! do this as the last thing, otherwise other threads will already have taken ownership of it !!
-		self->guest_fiber               = nullptr;             // reset current fiber
+		LE_JOBS_TRACE_RECORD( self->worker_idx, eJobEnd, self->guest_fiber->job_fun_ptr, self->guest_fiber - job_manager->fibers );
+		self->guest_fiber->stack = nullptr;         // Reset fiber stack
+		le_fiber_pool_release( self->guest_fiber ); // return fiber to pool !! do this as the last thing, otherwise other threads will already have taken ownership of it !!
+		self->guest_fiber = nullptr;                // reset current fiber
 	} else {
 		// Fiber has yielded: We must add it to the wait_list.
+		LE_JOBS_TRACE_RECORD( self->worker_idx, eFiberYield, self->guest_fiber->job_fun_ptr, self->guest_fiber - job_manager->fibers );
 		fiber_list_push_back( &self->wait_list, self->guest_fiber );
 		self->guest_fiber = nullptr;
 	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+// Returns true if there is anything this worker thread could do right now:
+// either a fiber on its wait list is ready to resume, or there is a job
+// in any of the job queues, and an idle fiber to execute it with.
+static bool le_worker_thread_has_pending_work( le_worker_thread_o *self ) {
+
+	for ( le_fiber_o *f = self->wait_list.begin; f != nullptr; f = f->list_next ) {
+		if ( nullptr == f->fiber_await_counter || 0 == counter_get_value( f->fiber_await_counter ) ) {
+			return true;
+		}
+	}
+
+	if ( uint32_t( job_manager->fibers_free_list.load() ) == POOL_INDEX_NONE ) {
+		// No idle fibers: we can't start any new jobs until a fiber is returned to the pool.
+		return false;
+	}
+
+	for ( size_t p = 0; p != JOB_PRIORITY_COUNT; ++p ) {
+
+		if ( lockfree_mpmc_queue_size( self->pinned_queues[ p ] ) ||
+		     lockfree_mpmc_queue_size( job_manager->injector_queues[ p ] ) ) {
+			return true;
+		}
+
+		for ( size_t i = 0; i != job_manager->worker_thread_count; ++i ) {
+			if ( work_stealing_deque_size( static_worker_threads[ i ]->job_queues[ p ] ) ) {
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+// ----------------------------------------------------------------------
+// Put worker thread to sleep until someone wakes it up via `park_word`.
+//
+// We must announce that we are about to park *before* we check for pending
+// work one last time: anyone who issues work after our check will then
+// see our bit in `parked_workers`, and wake us up. Anyone who issued work
+// before our check will have made that work visible to us.
+static void le_worker_thread_park( le_worker_thread_o *self ) {
+
+	const uint64_t bit       = uint64_t( 1 ) << self->worker_idx;
+	const uint32_t park_word = self->park_word.load();
+
+	job_manager->parked_workers.fetch_or( bit );
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+
+	if ( 0 == self->stop_thread && !le_worker_thread_has_pending_work( self ) ) {
+		futex_wait( &self->park_word, park_word );
+	}
+
+	job_manager->parked_workers.fetch_and( ~bit );
 }
 
 // ----------------------------------------------------------------------
 // Main loop for each worker thread
 //
+// If there is no work, a worker thread spins for a while before it parks.
+// The number of spin rounds adapts: if work turned up while spinning, we
+// spin longer next time - if we had to park, we spin for less time next
+// time round.
+//
 static void le_worker_thread_loop( le_worker_thread_o *self ) {
 
 	self->thread_id = std::this_thread::get_id();
 
+	uint32_t idle_rounds = 0;
+
 	while ( 0 == self->stop_thread ) {
-		le_worker_thread_dispatch( self );
+
+		if ( le_worker_thread_dispatch( self ) ) {
+			if ( idle_rounds != 0 && self->spin_count < WORKER_SPIN_COUNT_MAX ) {
+				// Spinning paid off, we found work before we had to park.
+				self->spin_count *= 2;
+			}
+			idle_rounds = 0;
+			continue;
+		}
+
+		if ( ++idle_rounds < self->spin_count ) {
+			cpu_relax();
+			continue;
+		}
+
+		le_worker_thread_park( self );
+
+		if ( self->spin_count > WORKER_SPIN_COUNT_MIN ) {
+			self->spin_count /= 2;
+		}
+
+		idle_rounds = 0;
+	}
+}
+
+// ----------------------------------------------------------------------
+// Choose a logical cpu for each worker thread, according to the current
+// placement policy, and sort each worker's steal victims so that workers
+// which share its socket (and numa node) come first.
+//
+// Must be called after all worker thread objects have been created, but
+// before any worker thread starts.
+static void le_job_manager_place_workers( size_t num_threads ) {
+
+	cpu_topology_t topology;
+
+	static_assert( uint32_t( LeJobsPlacement::ePhysicalCores ) == uint32_t( CpuPlacementPolicy::ePhysicalCores ) &&
+	                   uint32_t( LeJobsPlacement::eFillSocket ) == uint32_t( CpuPlacementPolicy::eFillSocket ) &&
+	                   uint32_t( LeJobsPlacement::eSpread ) == uint32_t( CpuPlacementPolicy::eSpread ),
+	               "placement policies must match" );
+
+	// If we can't discover the topology - or we're told not to pin - workers
+	// remain unpinned, and the OS scheduler decides where they run.
+	if ( worker_placement != LeJobsPlacement::eNone && cpu_topology_discover( &topology ) ) {
+
+		uint32_t cpus[ MAX_WORKER_THREAD_COUNT ];
+		cpu_topology_place_workers( &topology, CpuPlacementPolicy( worker_placement ), num_threads, cpus );
+
+		for ( size_t i = 0; i != num_threads; ++i ) {
+			static_worker_threads[ i ]->cpu = cpus[ i ];
+		}
+	}
+
+	for ( size_t i = 0; i != num_threads; ++i ) {
+
+		le_worker_thread_o *const w = static_worker_threads[ i ];
+
+		cpu_topology_cpu_t const *self_cpu = ( w->cpu != CPU_NONE ) ? cpu_topology_find( &topology, w->cpu ) : nullptr;
+
+		// Unpinned workers may run anywhere - for them, all victims are equally near.
+
+		w->steal_victims_count = 0;
+		w->steal_victims_near  = 0;
+
+		for ( int pass = 0; pass != 2; ++pass ) {
+			for ( size_t v = 0; v != num_threads; ++v ) {
+				if ( v == i ) {
+					continue;
+				}
+				cpu_topology_cpu_t const *victim_cpu = ( self_cpu && static_worker_threads[ v ]->cpu != CPU_NONE )
+				                                           ? cpu_topology_find( &topology, static_worker_threads[ v ]->cpu )
+				                                           : nullptr;
+
+				const bool is_near = !self_cpu ||
+				                     ( victim_cpu &&
+				                       victim_cpu->package_id == self_cpu->package_id &&
+				                       victim_cpu->numa_node == self_cpu->numa_node );
+
+				if ( is_near == ( pass == 0 ) ) {
+					w->steal_victims[ w->steal_victims_count++ ] = uint32_t( v );
+				}
+			}
+			if ( pass == 0 ) {
+				w->steal_victims_near = w->steal_victims_count;
+			}
+		}
 	}
 }
 
 // ----------------------------------------------------------------------
 
-static void le_job_manager_initialize( size_t num_threads ) {
+static void le_job_manager_initialize( size_t num_threads, size_t num_fibers ) {
 
 	assert( num_threads <= MAX_WORKER_THREAD_COUNT );
 	assert( num_threads > 0 && "num_threads must be > than 0" );
@@ -425,25 +970,57 @@ static void le_job_manager_initialize( size_t num_threads ) {
 
 	job_manager = new le_job_manager_o();
 
-	job_manager->job_queue = lockfree_ring_buffer_create( 10 ); // note size is given as a power of 2, so "10" means 1024 elements
+	for ( auto &q : job_manager->injector_queues ) {
+		q = lockfree_mpmc_queue_create( INJECTOR_QUEUE_SIZE_POT, sizeof( le_job_o ) );
+	}
+
+	job_manager->external_pinned_queue = lockfree_mpmc_queue_create( PINNED_QUEUE_SIZE_POT, sizeof( le_job_o ) );
 
-	// Allocate a number of fibers to execute jobs in.
-	for ( size_t i = 0; i != FIBER_POOL_SIZE; ++i ) {
-		job_manager->fibers[ i ] = le_fiber_create();
+#if ( LE_JOBS_TRACE > 0 )
+	for ( size_t i = 0; i != num_threads; ++i ) {
+		trace_rings[ i ] = job_trace_ring_create( TRACE_RING_SIZE_POT );
 	}
+	trace_rings[ TRACE_RING_EXTERNAL ] = job_trace_ring_create( TRACE_RING_SIZE_POT );
+	trace_tsc_origin                   = __rdtsc();
+	trace_steady_clock_origin_ns       = uint64_t( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count() );
+#endif
 
-	// Create a number of worker threads to host fibers in
+	counter_pool_initialize( job_manager );
+
+	if ( num_fibers == 0 ) {
+		num_fibers = DEFAULT_FIBER_POOL_SIZE;
+	}
+
+	assert( num_fibers < POOL_INDEX_NONE );
+
+	// Allocate a number of fibers to execute jobs in, and chain them into the fiber pool's free list.
+	job_manager->fibers      = new le_fiber_o[ num_fibers ];
+	job_manager->fiber_count = uint32_t( num_fibers );
+
+	for ( uint32_t i = 0; i != job_manager->fiber_count; ++i ) {
+		bool result = le_fiber_create_stack( &job_manager->fibers[ i ] );
+		assert( result && "could not allocate fiber stack" );
+		( void )result;
+		job_manager->fibers[ i ].pool_next = ( i + 1 == job_manager->fiber_count ) ? POOL_INDEX_NONE : i + 1;
+	}
+
+	job_manager->fibers_free_list = 0;
+
+	// Create all worker thread objects before starting any threads,
+	// so that worker threads may safely steal from each other's deques
+	// as soon as they start.
 	for ( size_t i = 0; i != num_threads; ++i ) {
 
 		le_worker_thread_o *w = new le_worker_thread_o();
 
-		w->thread = std::thread( le_worker_thread_loop, w );
+		for ( size_t p = 0; p != JOB_PRIORITY_COUNT; ++p ) {
+			w->job_queues[ p ]    = work_stealing_deque_create( WORKER_QUEUE_SIZE_POT, sizeof( le_job_o ) );
+			w->pinned_queues[ p ] = lockfree_mpmc_queue_create( PINNED_QUEUE_SIZE_POT, sizeof( le_job_o ) );
+		}
 
-		auto      pthread = w->thread.native_handle();
-		cpu_set_t mask;
-		CPU_ZERO( &mask );
-		CPU_SET( i + 1, &mask );
-		pthread_setaffinity_np( pthread, sizeof( mask ), &mask );
+		w->worker_idx = uint32_t( i );
+		w->spin_count = WORKER_SPIN_COUNT_MIN;
+		w->rand_state = 0x9E3779B97F4A7C15ull * ( i + 1 ); // any non-zero seed will do
 
 		// Thread in static ledger of threads so that
 		// we may retrieve thread-ids later.
@@ -451,6 +1028,37 @@ static void le_job_manager_initialize( size_t num_threads ) {
 	}
 
 	job_manager->worker_thread_count = num_threads;
+
+	le_job_manager_place_workers( num_threads );
+
+	// Create a number of worker threads to host fibers in
+	for ( size_t i = 0; i != num_threads; ++i ) {
+
+		le_worker_thread_o *w = static_worker_threads[ i ];
+
+		w->thread = std::thread( le_worker_thread_loop, w );
+
+		if ( w->cpu == CPU_NONE ) {
+			continue;
+		}
+
+		auto      pthread = w->thread.native_handle();
+		cpu_set_t mask;
+		CPU_ZERO( &mask );
+		CPU_SET( w->cpu, &mask );
+
+		if ( 0 != pthread_setaffinity_np( pthread, sizeof( mask ), &mask ) ) {
+			fprintf( stderr, "WARNING: le_jobs could not pin worker thread %zu to cpu %u - worker thread is not pinned.\n", i, w->cpu );
+			w->cpu = CPU_NONE;
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+
+static void le_job_manager_set_worker_placement( LeJobsPlacement placement ) {
+	assert( job_manager == nullptr && "worker placement must be set before job manager is initialised" );
+	worker_placement = placement;
 }
 
 // ----------------------------------------------------------------------
@@ -465,43 +1073,87 @@ static void le_job_manager_terminate() {
 		( *t )->stop_thread = 1;
 	}
 
+	// - Wake up any parked threads, so that they may observe the termination signal.
+
+	for ( le_worker_thread_o **t = &static_worker_threads[ 0 ]; *t != nullptr; ++t ) {
+		( *t )->park_word.fetch_add( 1 );
+		futex_wake( &( *t )->park_word, 1 );
+	}
+
 	// - Join all worker threads
 
 	for ( le_worker_thread_o **t = &static_worker_threads[ 0 ]; *t != nullptr; ++t ) {
 		( *t )->thread.join();
+	}
+
+	// - Delete worker threads, and their job queues - along with any leftover jobs.
+	//   We may only do this once all threads have joined, as threads might otherwise still
+	//   attempt to steal from each other.
+
+	for ( le_worker_thread_o **t = &static_worker_threads[ 0 ]; *t != nullptr; ++t ) {
+		for ( size_t p = 0; p != JOB_PRIORITY_COUNT; ++p ) {
+			work_stealing_deque_destroy( ( *t )->job_queues[ p ] );
+			lockfree_mpmc_queue_destroy( ( *t )->pinned_queues[ p ] );
+		}
 		delete ( *t );
 		( *t ) = nullptr;
 	}
 
-	for ( size_t i = 0; i != FIBER_POOL_SIZE; ++i ) {
-		le_fiber_destroy( job_manager->fibers[ i ] );
-		job_manager->fibers[ i ] = nullptr;
+	for ( uint32_t i = 0; i != job_manager->fiber_count; ++i ) {
+		le_fiber_destroy_stack( &job_manager->fibers[ i ] );
 	}
 
-	// attempt to delete any leftover jobs on the job queue.
-	void *ret;
-	while ( ( ret = lockfree_ring_buffer_trypop( job_manager->job_queue ) ) ) {
-		delete ( static_cast<le_job_o *>( ret ) );
+	delete[] job_manager->fibers;
+	job_manager->fibers      = nullptr;
+	job_manager->fiber_count = 0;
+
+	for ( auto &q : job_manager->injector_queues ) {
+		lockfree_mpmc_queue_destroy( q );
+		q = nullptr;
 	}
 
-	lockfree_ring_buffer_destroy( job_manager->job_queue );
+	lockfree_mpmc_queue_destroy( job_manager->external_pinned_queue );
 
-	{
-		std::scoped_lock lock( job_manager->counters_mtx );
-		// free all leftover counters.
-		for ( auto &c : job_manager->counters ) {
-			delete c;
-		}
-
-		// clear list of leftover counters.
-		job_manager->counters.clear();
+#if ( LE_JOBS_TRACE > 0 )
+	for ( auto &ring : trace_rings ) {
+		job_trace_ring_destroy( ring );
+		ring = nullptr;
 	}
+#endif
 
+	// Note that pooled counters are freed together with the job manager.
+	// Counters which were heap-allocated because the pool had run dry, and
+	// which were never waited for, are leaked.
 	delete job_manager;
 
 	job_manager = nullptr;
 }
 
+// ----------------------------------------------------------------------
+// Execute one job which was pinned to threads outside the job system, if any.
+// Called on a thread outside the job system: there is no fiber, which is why
+// we call the job function directly.
+//
+// Returns false if there was no job to execute.
+static bool le_job_manager_run_external_pinned_job() {
+
+	le_job_o job;
+
+	if ( !lockfree_mpmc_queue_trypop( job_manager->external_pinned_queue, &job ) ) {
+		return false;
+	}
+
+	LE_JOBS_TRACE_RECORD( TRACE_RING_EXTERNAL, eJobBegin, job.fun_ptr, 0 );
+	job.fun_ptr( job.fun_param );
+	LE_JOBS_TRACE_RECORD( TRACE_RING_EXTERNAL, eJobEnd, job.fun_ptr, 0 );
+
+	if ( job.complete_counter ) {
+		counter_decrement( job.complete_counter );
+	}
+
+	return true;
+}
+
 // ----------------------------------------------------------------------
 // polls counter, and will not return until counter == target_value
 static void le_job_manager_wait_for_counter_and_free( counter_t *counter, uint32_t target_value ) {
@@ -509,56 +1161,225 @@ static void le_job_manager_wait_for_counter_and_free( counter_t *counter, uint32
 	auto current_worker = get_current_thread();
 
 	if ( nullptr == current_worker ) {
-		for ( ; counter->data != target_value; ) {
-			// called from the main thread - we must wait until
-			// all jobs which affect the counter have completed.
-			std::this_thread::sleep_for( std::chrono::nanoseconds( 100 ) );
+		// Called from the main thread - we must wait until
+		// all jobs which affect the counter have completed.
+		//
+		// While we wait, we execute any jobs which were pinned to
+		// threads outside the job system - the counter might depend on
+		// these jobs.
+		//
+		// Short jobs will often complete while we spin. If they don't,
+		// we park this thread until the last job decrements the counter,
+		// or until a job is pinned to us.
+
+		LE_JOBS_TRACE_RECORD( TRACE_RING_EXTERNAL, eCounterWaitBegin, counter, 0 );
+
+		for ( uint32_t i = 0; i != WAITER_SPIN_COUNT && counter_get_value( counter ) != target_value; ++i ) {
+			if ( le_job_manager_run_external_pinned_job() ) {
+				i = 0;
+			} else {
+				cpu_relax();
+			}
 		}
+
+		if ( target_value == 0 ) {
+			// Tell whoever decrements the counter to zero that they must wake us up.
+			counter->data.fetch_or( uint64_t( COUNTER_WAITER_EXTERNAL ) << 32 );
+			for ( ;; ) {
+				// We must sample the park word before we check our conditions: anyone
+				// who changes these conditions after our check will bump the park word,
+				// so that futex_wait returns immediately.
+				const uint32_t park_word = job_manager->external_park_word.load();
+				if ( counter_get_value( counter ) == 0 ) {
+					break;
+				}
+				if ( le_job_manager_run_external_pinned_job() ) {
+					continue;
+				}
+				futex_wait( &job_manager->external_park_word, park_word );
+			}
+		} else {
+			// Counters only signal waiters once they reach zero.
+			for ( ; counter_get_value( counter ) != target_value; ) {
+				if ( !le_job_manager_run_external_pinned_job() ) {
+					std::this_thread::sleep_for( std::chrono::nanoseconds( 100 ) );
+				}
+			}
+		}
+
+		LE_JOBS_TRACE_RECORD( TRACE_RING_EXTERNAL, eCounterWaitEnd, counter, 0 );
 	} else {
 		// This method has been issued from a job, and not from the main thread.
 		// We must issue a yield, but not before we have set the wait_counter for the
-		// current worker.
+		// current worker, and told the counter which worker to wake up once it
+		// reaches zero - in case that worker should be parked by then.
+		LE_JOBS_TRACE_RECORD( current_worker->worker_idx, eCounterWaitBegin, counter, current_worker->guest_fiber - job_manager->fibers );
 		current_worker->guest_fiber->fiber_await_counter = counter;
+		counter->data.fetch_or( uint64_t( COUNTER_WAITER_WORKER_0 + current_worker->worker_idx ) << 32 );
 		// Switch back to current worker's host fiber
 		asm_switch( &current_worker->host_fiber, current_worker->guest_fiber, 0 );
 		// If we're back from the switch, this means that the counter has reached
 		// zero.
+		current_worker->guest_fiber->fiber_await_counter = nullptr;
+		LE_JOBS_TRACE_RECORD( current_worker->worker_idx, eCounterWaitEnd, counter, current_worker->guest_fiber - job_manager->fibers );
 	}
 
 	// --------| invariant: counter must be at zero.
-	assert( counter->data == 0 );
-
-	// Remove counter from list of counters owned by job manager
-	{
-		// we must protect this using a mutex, as other threads might want to add/remove counters
-		// and this might lead to a race condition on the forward_list of counters.
-		std::scoped_lock lock( job_manager->counters_mtx );
-		job_manager->counters.remove( counter );
-		// free counter memory
-		delete counter;
+	assert( counter_get_value( counter ) == 0 );
+
+	// Return counter to the counter pool
+	counter_release( counter );
+}
+
+// ----------------------------------------------------------------------
+// Executes `job` inline, on the fiber which is currently running on `worker`.
+// We use this to make room in a full queue which nobody else might drain.
+static void le_worker_thread_run_job_inline( le_worker_thread_o *worker, le_job_o const &job ) {
+
+	LE_JOBS_TRACE_RECORD( worker->worker_idx, eJobBegin, job.fun_ptr, worker->guest_fiber - job_manager->fibers );
+	job.fun_ptr( job.fun_param );
+	LE_JOBS_TRACE_RECORD( worker->worker_idx, eJobEnd, job.fun_ptr, worker->guest_fiber - job_manager->fibers );
+
+	if ( job.complete_counter ) {
+		counter_decrement( job.complete_counter );
+	}
+}
+
+// ----------------------------------------------------------------------
+// Push a job onto the most appropriate job queue for its priority:
+//
+// If called from within a fiber, the job goes onto the current worker thread's
+// own deque, from where other worker threads may steal it. If called from
+// outside the job system - or if the current worker's deque is full - the job
+// goes onto the shared injector queue.
+//
+// If the injector queue is full, we must wake up workers before we wait for
+// room: jobs which we pushed earlier are only announced to workers once all
+// jobs have been pushed, and parked workers would otherwise never drain the
+// queue. A worker which finds the queue full helps by running a job from the
+// queue itself - it might be the only worker thread.
+static void le_job_manager_push_job( le_worker_thread_o *current_worker, le_job_o const *job, LeJobPriority priority ) {
+	const size_t p = size_t( priority );
+	if ( current_worker && work_stealing_deque_trypush( current_worker->job_queues[ p ], job ) ) {
+		return;
+	}
+
+	lockfree_mpmc_queue_t *injector_queue = job_manager->injector_queues[ p ];
+
+	while ( !lockfree_mpmc_queue_trypush( injector_queue, job ) ) {
+
+		le_job_manager_unpark_workers( uint32_t( job_manager->worker_thread_count ) );
+
+		le_job_o queued_job;
+
+		if ( current_worker && lockfree_mpmc_queue_trypop( injector_queue, &queued_job ) ) {
+			le_worker_thread_run_job_inline( current_worker, queued_job );
+		} else {
+			std::this_thread::yield();
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+// Called when `pinned_queue` is full while we try to push onto it.
+//
+// If the calling thread is the one which drains `pinned_queue` - a thread
+// outside the job system pinning jobs to itself, or a worker pinning jobs to
+// itself - pop and execute one job from it, so that there is room again.
+// A worker executes that job inline, on the fiber which is currently running.
+//
+// Returns false if the calling thread may not drain `pinned_queue`, or if
+// there was no job to execute; the caller must then wait for another thread
+// to make room.
+static bool le_job_manager_run_own_pinned_job( le_worker_thread_o *current_worker, lockfree_mpmc_queue_t *pinned_queue ) {
+
+	if ( current_worker == nullptr ) {
+		return pinned_queue == job_manager->external_pinned_queue &&
+		       le_job_manager_run_external_pinned_job();
+	}
+
+	bool is_own_queue = false;
+
+	for ( size_t p = 0; p != JOB_PRIORITY_COUNT; ++p ) {
+		is_own_queue |= ( current_worker->pinned_queues[ p ] == pinned_queue );
+	}
+
+	le_job_o job;
+
+	if ( !is_own_queue || !lockfree_mpmc_queue_trypop( pinned_queue, &job ) ) {
+		return false;
 	}
+
+	le_worker_thread_run_job_inline( current_worker, job );
+
+	return true;
 }
 
 // ----------------------------------------------------------------------
 // copies jobs into job queue
-static void le_job_manager_run_jobs( le_job_o *jobs, uint32_t num_jobs, counter_t **p_counter ) {
+static void le_job_manager_run_jobs_ex( le_job_o *jobs, uint32_t num_jobs, counter_t **p_counter, LeJobPriority priority, int32_t affinity ) {
+
+	assert( size_t( priority ) < JOB_PRIORITY_COUNT );
+
+	counter_t *counter = counter_acquire( num_jobs );
 
-	auto counter  = new counter_t();
-	counter->data = num_jobs;
+	le_worker_thread_o *current_worker = get_current_thread();
 
-	{
-		std::scoped_lock lock( job_manager->counters_mtx );
-		job_manager->counters.emplace_front( counter );
+	if ( affinity == LE_JOB_AFFINITY_CALLING_THREAD ) {
+		affinity = current_worker ? int32_t( current_worker->worker_idx ) : AFFINITY_EXTERNAL;
+	}
+
+	assert( affinity < int32_t( job_manager->worker_thread_count ) && "affinity must name a valid worker thread" );
+
+	lockfree_mpmc_queue_t *pinned_queue = nullptr;
+
+	if ( affinity == AFFINITY_EXTERNAL ) {
+		pinned_queue = job_manager->external_pinned_queue;
+	} else if ( affinity >= 0 ) {
+		pinned_queue = static_worker_threads[ affinity ]->pinned_queues[ size_t( priority ) ];
 	}
 
 	le_job_o *      j        = jobs;
 	le_job_o *const jobs_end = jobs + num_jobs;
 
 	for ( ; j != jobs_end; j++ ) {
-		// Note that we must store a pointer to counter with each job,
-		// which is why we must allocate job objects for each job.
-		// Jobs are freed when
-		lockfree_ring_buffer_push( job_manager->job_queue, new le_job_o{ j->fun_ptr, j->fun_param, counter } );
+		// Note that we must store a pointer to counter with each job.
+		// Jobs are copied into job queue slots, which means that issuing
+		// jobs does not allocate.
+		const le_job_o job{ j->fun_ptr, j->fun_param, counter };
+		if ( pinned_queue ) {
+			while ( !lockfree_mpmc_queue_trypush( pinned_queue, &job ) ) {
+				// Queue is full. If we are the only thread which drains this queue,
+				// waiting for space would spin forever: make room by running one of
+				// the queued jobs ourselves.
+				if ( le_job_manager_run_own_pinned_job( current_worker, pinned_queue ) ) {
+					continue;
+				}
+				// Otherwise, the thread which drains this queue might be parked - we
+				// only announce jobs once all have been pushed, so we must wake it now.
+				if ( affinity == AFFINITY_EXTERNAL ) {
+					le_job_manager_unpark_external_threads();
+				} else {
+					le_worker_thread_unpark( static_worker_threads[ affinity ] );
+				}
+				std::this_thread::yield();
+			}
+		} else {
+			le_job_manager_push_job( current_worker, &job, priority );
+		}
+	}
+
+	if ( affinity == AFFINITY_EXTERNAL ) {
+		// Jobs will be picked up once we wait for a counter - but another
+		// thread outside the job system might already be waiting.
+		le_job_manager_unpark_external_threads();
+	} else if ( affinity >= 0 ) {
+		// Only the worker which jobs are pinned to may pick them up.
+		le_worker_thread_unpark( static_worker_threads[ affinity ] );
+	} else {
+		// Wake up parked workers to pick up new jobs - the current worker (if any)
+		// is busy running this fiber, and can't pick up jobs until this fiber yields.
+		le_job_manager_unpark_workers( num_jobs );
 	}
 
 	// store address back into parameter, so that caller knows about our counter.
@@ -569,14 +1390,278 @@ static void le_job_manager_run_jobs( le_job_o *jobs, uint32_t num_jobs, counter_
 
 // ----------------------------------------------------------------------
 
+static void le_job_manager_run_jobs( le_job_o *jobs, uint32_t num_jobs, counter_t **p_counter ) {
+	le_job_manager_run_jobs_ex( jobs, num_jobs, p_counter, LeJobPriority::eNormal, LE_JOB_AFFINITY_ANY );
+}
+
+// ----------------------------------------------------------------------
+
+struct parallel_for_chunk_t {
+	le_jobs_api::range_fun_ptr_t fun;
+	void *                       user_data;
+	uint32_t                     range_begin;
+	uint32_t                     range_end;
+};
+
+static void parallel_for_chunk_fun( void *param ) {
+	auto chunk = static_cast<parallel_for_chunk_t *>( param );
+	chunk->fun( chunk->range_begin, chunk->range_end, chunk->user_data );
+}
+
+// ----------------------------------------------------------------------
+// Split range into chunks of at most grain_size elements, issue a job for each chunk
+// but the first one, which we process on the calling thread. Then wait for all jobs.
+//
+// Chunk descriptors live on the caller's stack, which is safe because we don't return
+// before all jobs have completed.
+static void le_job_manager_parallel_for( uint32_t begin, uint32_t end, uint32_t grain_size, le_jobs_api::range_fun_ptr_t fun, void *user_data ) {
+
+	if ( end <= begin ) {
+		return;
+	}
+
+	const uint32_t count = end - begin;
+
+	if ( grain_size == 0 ) {
+		const uint32_t num_chunks = uint32_t( job_manager->worker_thread_count ) * PARALLEL_FOR_CHUNKS_PER_WORKER;
+		grain_size                = ( count + num_chunks - 1 ) / num_chunks;
+	}
+
+	uint32_t num_chunks = ( count + grain_size - 1 ) / grain_size;
+
+	if ( num_chunks > PARALLEL_FOR_MAX_CHUNKS ) {
+		grain_size = ( count + PARALLEL_FOR_MAX_CHUNKS - 1 ) / PARALLEL_FOR_MAX_CHUNKS;
+		num_chunks = ( count + grain_size - 1 ) / grain_size;
+	}
+
+	if ( num_chunks == 1 ) {
+		// Not worth issuing any jobs.
+		fun( begin, end, user_data );
+		return;
+	}
+
+	parallel_for_chunk_t chunks[ PARALLEL_FOR_MAX_CHUNKS ];
+	le_job_o             jobs[ PARALLEL_FOR_MAX_CHUNKS ];
+
+	for ( uint32_t i = 0; i != num_chunks; ++i ) {
+		const uint32_t range_begin = begin + i * grain_size;
+		const uint32_t range_end   = ( i + 1 == num_chunks ) ? end : range_begin + grain_size;
+
+		chunks[ i ] = { fun, user_data, range_begin, range_end };
+		jobs[ i ]   = { parallel_for_chunk_fun, &chunks[ i ] };
+	}
+
+	counter_t *counter;
+	le_job_manager_run_jobs( jobs + 1, num_chunks - 1, &counter );
+
+	parallel_for_chunk_fun( &chunks[ 0 ] );
+
+	le_job_manager_wait_for_counter_and_free( counter, 0 );
+}
+
+// ----------------------------------------------------------------------
+
+struct le_job_graph_task_t {
+	le_job_graph_o *       graph;
+	le_jobs_api::fun_ptr_t fun_ptr;
+	void *                 fun_param;
+	uint32_t               num_dependencies; // number of tasks which must complete before this task may start
+	std::vector<uint32_t>  dependents;       // indices of tasks which depend on this task
+};
+
+struct le_job_graph_o {
+	std::vector<le_job_graph_task_t>   tasks;
+	std::vector<std::atomic<uint32_t>> num_pending_dependencies; // per task, counts down while graph executes
+	counter_t *                        counter = nullptr;        // counter for current submission, owned by le_job_manager
+};
+
+// ----------------------------------------------------------------------
+
+static le_job_graph_o *le_job_graph_create() {
+	auto self = new le_job_graph_o();
+	return self;
+}
+
+// ----------------------------------------------------------------------
+
+static void le_job_graph_destroy( le_job_graph_o *self ) {
+	delete self;
+}
+
+// ----------------------------------------------------------------------
+
+static void le_job_graph_reset( le_job_graph_o *self ) {
+	self->tasks.clear();
+}
+
+// ----------------------------------------------------------------------
+
+static uint32_t le_job_graph_add_task( le_job_graph_o *self, le_jobs_api::fun_ptr_t fun, void *user_data ) {
+	self->tasks.push_back( { self, fun, user_data, 0, {} } );
+	return uint32_t( self->tasks.size() - 1 );
+}
+
+// ----------------------------------------------------------------------
+
+static void le_job_graph_add_dependency( le_job_graph_o *self, uint32_t task, uint32_t dependency ) {
+	assert( task < self->tasks.size() && dependency < self->tasks.size() && "task id out of bounds" );
+	assert( task != dependency && "task must not depend on itself" );
+	self->tasks[ task ].num_dependencies++;
+	self->tasks[ dependency ].dependents.push_back( task );
+}
+
+// ----------------------------------------------------------------------
+// Executes a task, then issues any dependent tasks which have become ready.
+//
+// We decrement the graph's counter only once we're done with the graph, as
+// the graph may be destroyed as soon as the counter reaches zero.
+static void le_job_graph_run_task( void *param ) {
+
+	auto task  = static_cast<le_job_graph_task_t *>( param );
+	auto graph = task->graph;
+
+	task->fun_ptr( task->fun_param );
+
+	le_worker_thread_o *current_worker = get_current_thread();
+
+	uint32_t num_issued = 0;
+
+	for ( uint32_t dependent : task->dependents ) {
+		if ( 1 == graph->num_pending_dependencies[ dependent ].fetch_sub( 1 ) ) {
+			// This was the last dependency we were waiting for, dependent task may start.
+			const le_job_o job{ le_job_graph_run_task, &graph->tasks[ dependent ], nullptr };
+			le_job_manager_push_job( current_worker, &job, LeJobPriority::eNormal );
+			num_issued++;
+		}
+	}
+
+	if ( num_issued ) {
+		le_job_manager_unpark_workers( num_issued );
+	}
+
+	counter_decrement( graph->counter );
+}
+
+// ----------------------------------------------------------------------
+// Returns true if all tasks can be reached via dependencies from tasks
+// without dependencies - which is not the case if the graph has a cycle.
+static bool le_job_graph_is_acyclic( le_job_graph_o const *self ) {
+
+	std::vector<uint32_t> num_dependencies( self->tasks.size() );
+	std::vector<uint32_t> ready;
+
+	for ( uint32_t i = 0; i != self->tasks.size(); ++i ) {
+		num_dependencies[ i ] = self->tasks[ i ].num_dependencies;
+		if ( num_dependencies[ i ] == 0 ) {
+			ready.push_back( i );
+		}
+	}
+
+	size_t num_visited = 0;
+
+	while ( !ready.empty() ) {
+		uint32_t t = ready.back();
+		ready.pop_back();
+		num_visited++;
+		for ( uint32_t d : self->tasks[ t ].dependents ) {
+			if ( 0 == --num_dependencies[ d ] ) {
+				ready.push_back( d );
+			}
+		}
+	}
+
+	return num_visited == self->tasks.size();
+}
+
+// ----------------------------------------------------------------------
+
+static void le_job_graph_submit( le_job_graph_o *self, counter_t **p_counter ) {
+
+	assert( le_job_graph_is_acyclic( self ) && "job graph must not contain cycles" );
+
+	const uint32_t num_tasks = uint32_t( self->tasks.size() );
+
+	if ( self->num_pending_dependencies.size() != num_tasks ) {
+		self->num_pending_dependencies = std::vector<std::atomic<uint32_t>>( num_tasks );
+	}
+
+	for ( uint32_t i = 0; i != num_tasks; ++i ) {
+		self->num_pending_dependencies[ i ] = self->tasks[ i ].num_dependencies;
+	}
+
+	// Counter must be set up before we issue the first task.
+	self->counter = counter_acquire( num_tasks );
+
+	le_worker_thread_o *current_worker = get_current_thread();
+
+	uint32_t num_issued = 0;
+
+	for ( auto &task : self->tasks ) {
+		if ( task.num_dependencies == 0 ) {
+			const le_job_o job{ le_job_graph_run_task, &task, nullptr };
+			le_job_manager_push_job( current_worker, &job, LeJobPriority::eNormal );
+			num_issued++;
+		}
+	}
+
+	le_job_manager_unpark_workers( num_issued );
+
+	if ( p_counter ) {
+		*p_counter = self->counter;
+	}
+}
+
+// ----------------------------------------------------------------------
+// Write events recorded since the job system was initialised (up to the capacity
+// of the trace rings) to a file in Chrome `trace_event` JSON format.
+//
+// Events which are recorded while we write may be missing or garbled, which is
+// why you should call this while the job system is quiet, e.g. between frames.
+static bool le_job_manager_write_trace( char const *file_path ) {
+#if ( LE_JOBS_TRACE > 0 )
+	assert( job_manager );
+
+	char        names[ MAX_WORKER_THREAD_COUNT + 1 ][ 32 ]{};
+	char const *name_ptrs[ MAX_WORKER_THREAD_COUNT + 1 ]{};
+
+	for ( size_t i = 0; i != MAX_WORKER_THREAD_COUNT + 1; ++i ) {
+		if ( i == TRACE_RING_EXTERNAL ) {
+			snprintf( names[ i ], sizeof( names[ i ] ), "external" );
+		} else {
+			snprintf( names[ i ], sizeof( names[ i ] ), "worker %zu", i );
+		}
+		name_ptrs[ i ] = names[ i ];
+	}
+
+	return job_trace_write_chrome_json( file_path, trace_rings, name_ptrs, MAX_WORKER_THREAD_COUNT + 1, trace_tsc_origin, trace_steady_clock_origin_ns );
+#else
+	( void )file_path;
+	return false;
+#endif
+}
+
+// ----------------------------------------------------------------------
+
 LE_MODULE_REGISTER_IMPL( le_jobs, api ) {
 
 	static_cast<le_jobs_api *>( api )->yield                     = le_fiber_yield;
 	static_cast<le_jobs_api *>( api )->get_current_worker_id     = get_current_worker_thread_id;
 	static_cast<le_jobs_api *>( api )->run_jobs                  = le_job_manager_run_jobs;
+	static_cast<le_jobs_api *>( api )->run_jobs_ex               = le_job_manager_run_jobs_ex;
 	static_cast<le_jobs_api *>( api )->initialize                = le_job_manager_initialize;
 	static_cast<le_jobs_api *>( api )->terminate                 = le_job_manager_terminate;
+	static_cast<le_jobs_api *>( api )->set_worker_placement      = le_job_manager_set_worker_placement;
 	static_cast<le_jobs_api *>( api )->wait_for_counter_and_free = le_job_manager_wait_for_counter_and_free;
+	static_cast<le_jobs_api *>( api )->parallel_for              = le_job_manager_parallel_for;
+	static_cast<le_jobs_api *>( api )->write_trace               = le_job_manager_write_trace;
+
+	auto &le_job_graph_i          = static_cast<le_jobs_api *>( api )->le_job_graph_i;
+	le_job_graph_i.create         = le_job_graph_create;
+	le_job_graph_i.destroy        = le_job_graph_destroy;
+	le_job_graph_i.reset          = le_job_graph_reset;
+	le_job_graph_i.add_task       = le_job_graph_add_task;
+	le_job_graph_i.add_dependency = le_job_graph_add_dependency;
+	le_job_graph_i.submit         = le_job_graph_submit;
 
 	//	le_core_load_library_persistently( "libpthread.so" );
 }
@@ -3,12 +3,38 @@
 
 #include "le_core/le_core.h"
 
+struct le_job_graph_o;
+
+// Jobs are drained strictly in order of priority: a worker thread only picks up
+// a job of lower priority if there are no jobs of higher priority available.
+enum class LeJobPriority : uint32_t {
+	eFrameCritical = 0, // latency-critical work which the current frame waits for
+	eNormal,            // default priority
+	eBackground,        // bulk work which may take several frames, e.g. asset streaming
+};
+
+// Affinity for jobs issued via `run_jobs_ex`: any value >= 0 pins jobs to the
+// worker thread with the given id.
+constexpr int32_t LE_JOB_AFFINITY_ANY            = -1; // any worker thread may execute jobs
+constexpr int32_t LE_JOB_AFFINITY_CALLING_THREAD = -2; // only the issuing thread may execute jobs (see note on run_jobs_ex)
+
+// How to place worker threads onto logical cpus. Only logical cpus which the process
+// may run on (see `sched_getaffinity`) are considered. Unless there are more worker
+// threads than physical cores, the first physical core is left to the main thread.
+enum class LeJobsPlacement : uint32_t {
+	ePhysicalCores = 0, // default: one worker per physical core, SMT siblings only once all cores are taken
+	eFillSocket,        // fill one socket before moving to the next - workers share caches, and memory
+	eSpread,            // distribute workers evenly across sockets - maximises memory bandwidth
+	eNone,              // don't pin worker threads, leave placement to the OS scheduler
+};
+
 // clang-format off
 struct le_jobs_api {
 
 	struct counter_t;
 
 	typedef void ( *fun_ptr_t )( void * );
+	typedef void ( *range_fun_ptr_t )( uint32_t range_begin, uint32_t range_end, void *user_data );
 	
 	/* A Job is a function pointer with a complete_counter which gets decreased
 	 * once the job is complete.
@@ -23,8 +49,17 @@ struct le_jobs_api {
 	 * before any other method involving the job system; 
 	 * 
 	 * `num_threads` tells us how many worker threads to initialise.
+	 * `num_fibers` tells us how many fibers to allocate - this limits how many jobs may be
+	 * in flight (running, or waiting for other jobs) at the same time. Each fiber comes with 
+	 * its own stack. Set to 0 to use the default number of fibers (128).
 	 */
-	void ( * initialize                ) ( size_t num_threads );
+	void ( * initialize                ) ( size_t num_threads, size_t num_fibers );
+
+	/* Set placement policy for worker threads. Must be called before `initialize`
+	 * to have any effect. Stealing prefers victims which share our socket, so that
+	 * jobs tend to stay close to the caches, and memory which they touch.
+	 */
+	void ( * set_worker_placement      ) ( LeJobsPlacement placement );
 	void ( * terminate                 ) ( );
 
 	/* Adds num_jobs to the job system queue, and immediately starts running them.
@@ -33,13 +68,38 @@ struct le_jobs_api {
 	 * with `num_jobs`. Each jobs decrements counter once it completes.
 	 * 
 	 * Once all jobs are complete `counter` will be at 0.
-     *
+	 *
+	 * Job queues are bounded - the shared queue holds 65536 jobs per priority. If the
+	 * queue is full, the calling thread wakes all worker threads, and waits until they
+	 * have made room (a worker thread runs queued jobs itself, instead). Issuing more
+	 * jobs than fit into the queue is therefore safe, but the calling thread may
+	 * block until some of these jobs have been executed.
 	 */
 	void ( * run_jobs                  ) ( le_job_o* jobs, uint32_t num_jobs, counter_t** counter );
 
+	/* Like run_jobs, but with explicit priority, and affinity.
+	 *
+	 * Jobs which are pinned to a worker thread (`affinity` >= 0) are never stolen
+	 * by other worker threads.
+	 *
+	 * Jobs pinned to the calling thread (`LE_JOB_AFFINITY_CALLING_THREAD`) issued from
+	 * outside the job system (typically: from the main thread) are executed from within
+	 * `wait_for_counter_and_free` on the main thread. If there is more than one thread
+	 * outside the job system, any of these may pick up such jobs while it waits.
+	 * Note that these jobs don't run inside a fiber, and must not yield.
+	 *
+	 * Pinned jobs are held in bounded queues (1024 jobs per queue). If a pinned queue
+	 * is full, and the calling thread is the thread which drains it, the calling thread
+	 * executes queued jobs inline until there is room. Otherwise, the calling thread
+	 * wakes the thread which drains the queue, and yields until that thread has made
+	 * room.
+	 */
+	void ( * run_jobs_ex               ) ( le_job_o* jobs, uint32_t num_jobs, counter_t** counter, LeJobPriority priority, int32_t affinity );
+
 	/* Wait until counter == target value.
 	 * 
-	 * When called on the main thread, this method will spin-lock until counter is at target value.
+	 * When called on the main thread, this method will spin-lock until counter is at target value,
+	 * and execute any jobs which were pinned to this thread in the meantime.
 	 * When called from within the job system, this method will yield until counter is at target value.
 	 * 
 	 * Once counter has reached target value, the counter is freed within the job system,
@@ -53,6 +113,51 @@ struct le_jobs_api {
 	// return id of current worker thread (0..MAX_THREADS), or -1 if called from outside job system.
 	int32_t (* get_current_worker_id)(void); 
 
+	/* Call `fun` over sub-ranges of [begin, end), distributing sub-ranges over worker threads,
+	 * and wait until all sub-ranges have been processed.
+	 *
+	 * Sub-ranges hold at most `grain_size` elements - if `grain_size` is 0, a grain size is
+	 * chosen based on the number of worker threads. The calling thread processes the first
+	 * sub-range itself.
+	 *
+	 * May be called from the main thread, or from within a job.
+	 */
+	void ( * parallel_for              ) ( uint32_t begin, uint32_t end, uint32_t grain_size, range_fun_ptr_t fun, void *user_data );
+
+	/* A job graph is a set of tasks, with dependencies between tasks. Once submitted, each task
+	 * is issued as a job as soon as all the tasks it depends on have completed.
+	 *
+	 * A job graph may be submitted again once its counter has been waited for - this allows
+	 * you to build a graph once and to re-use it every frame.
+	 *
+	 */
+	struct le_job_graph_interface_t {
+		le_job_graph_o * ( * create         ) ( );
+		void             ( * destroy        ) ( le_job_graph_o* self );
+		void             ( * reset          ) ( le_job_graph_o* self ); // remove all tasks and dependencies
+
+		// returns task id, which you may use to declare dependencies
+		uint32_t         ( * add_task       ) ( le_job_graph_o* self, fun_ptr_t fun, void* user_data );
+
+		// declare that `task` must not start before `dependency` has completed
+		void             ( * add_dependency ) ( le_job_graph_o* self, uint32_t task, uint32_t dependency );
+
+		// Issue all tasks without dependencies. `counter` reaches 0 once all tasks in the graph have completed;
+		// you must wait for this counter (via `wait_for_counter_and_free`) before you submit, modify or destroy the graph.
+		void             ( * submit         ) ( le_job_graph_o* self, counter_t** counter );
+	};
+
+	le_job_graph_interface_t le_job_graph_i;
+
+	/* Write job system events (job begin/end, fiber yield/resume, counter waits) to a file
+	 * in Chrome `trace_event` JSON format, which you can view in `chrome://tracing`.
+	 *
+	 * Events are only recorded if le_jobs was compiled with `LE_JOBS_TRACE=1` - otherwise
+	 * recording compiles away entirely, and this method returns false.
+	 *
+	 * Call this while the job system is quiet - e.g. between frames.
+	 */
+	bool ( * write_trace               ) ( char const * file_path );
 };
 // clang-format on
 LE_MODULE( le_jobs );
@@ -68,11 +173,17 @@ using job_t     = le_jobs_api::le_job_o;
 
 static const auto &initialize                = api -> initialize;
 static const auto &terminate                 = api -> terminate;
+static const auto &set_worker_placement      = api -> set_worker_placement;
 static const auto &run_jobs                  = api -> run_jobs;
+static const auto &run_jobs_ex               = api -> run_jobs_ex;
 static const auto &wait_for_counter_and_free = api -> wait_for_counter_and_free;
 
 static const auto &yield                 = api -> yield;
 static const auto &get_current_worker_id = api -> get_current_worker_id;
+static const auto &parallel_for          = api -> parallel_for;
+static const auto &write_trace           = api -> write_trace;
+
+static const auto &le_job_graph_i = api -> le_job_graph_i;
 
 } // namespace le_jobs
 
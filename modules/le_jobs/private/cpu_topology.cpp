@@ -0,0 +1,194 @@
+#include "cpu_topology.h"
+
+#include <algorithm>
+#include <dirent.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+
+// ----------------------------------------------------------------------
+// Read a single unsigned integer from a sysfs file - returns false if the
+// file could not be read, in which case `value` remains untouched.
+static bool sysfs_read_uint( char const *path, uint32_t *value ) {
+	FILE *file = fopen( path, "r" );
+	if ( !file ) {
+		return false;
+	}
+	unsigned int v      = 0;
+	bool         result = ( 1 == fscanf( file, "%u", &v ) );
+	fclose( file );
+	if ( result ) {
+		*value = v;
+	}
+	return result;
+}
+
+// ----------------------------------------------------------------------
+// Numa node for a cpu is given by a `nodeN` entry in the cpu's sysfs directory.
+static uint32_t sysfs_read_numa_node( uint32_t cpu ) {
+	char path[ 64 ];
+	snprintf( path, sizeof( path ), "/sys/devices/system/cpu/cpu%u", cpu );
+
+	DIR *dir = opendir( path );
+	if ( !dir ) {
+		return 0;
+	}
+
+	uint32_t node = 0;
+	for ( dirent *entry; ( entry = readdir( dir ) ); ) {
+		unsigned int n;
+		if ( 1 == sscanf( entry->d_name, "node%u", &n ) ) {
+			node = n;
+			break;
+		}
+	}
+
+	closedir( dir );
+	return node;
+}
+
+// ----------------------------------------------------------------------
+
+bool cpu_topology_discover( cpu_topology_t *topology ) {
+
+	topology->cpus.clear();
+
+	cpu_set_t mask;
+	CPU_ZERO( &mask );
+
+	if ( 0 != sched_getaffinity( 0, sizeof( mask ), &mask ) ) {
+		return false;
+	}
+
+	for ( uint32_t cpu = 0; cpu != CPU_SETSIZE; ++cpu ) {
+
+		if ( !CPU_ISSET( cpu, &mask ) ) {
+			continue;
+		}
+
+		// Defaults in case sysfs is not available: each cpu is its own core.
+		cpu_topology_cpu_t entry{ cpu, cpu, 0, 0 };
+
+		char path[ 96 ];
+		snprintf( path, sizeof( path ), "/sys/devices/system/cpu/cpu%u/topology/core_id", cpu );
+		sysfs_read_uint( path, &entry.core_id );
+		snprintf( path, sizeof( path ), "/sys/devices/system/cpu/cpu%u/topology/physical_package_id", cpu );
+		sysfs_read_uint( path, &entry.package_id );
+		entry.numa_node = sysfs_read_numa_node( cpu );
+
+		topology->cpus.push_back( entry );
+	}
+
+	std::sort( topology->cpus.begin(), topology->cpus.end(), []( cpu_topology_cpu_t const &lhs, cpu_topology_cpu_t const &rhs ) {
+		if ( lhs.package_id != rhs.package_id ) {
+			return lhs.package_id < rhs.package_id;
+		}
+		if ( lhs.core_id != rhs.core_id ) {
+			return lhs.core_id < rhs.core_id;
+		}
+		return lhs.cpu < rhs.cpu;
+	} );
+
+	return !topology->cpus.empty();
+}
+
+// ----------------------------------------------------------------------
+
+cpu_topology_cpu_t const *cpu_topology_find( cpu_topology_t const *topology, uint32_t cpu ) {
+	for ( auto const &c : topology->cpus ) {
+		if ( c.cpu == cpu ) {
+			return &c;
+		}
+	}
+	return nullptr;
+}
+
+// ----------------------------------------------------------------------
+
+void cpu_topology_place_workers( cpu_topology_t const *topology, CpuPlacementPolicy policy, size_t num_workers, uint32_t *cpus ) {
+
+	if ( topology->cpus.empty() || num_workers == 0 ) {
+		return;
+	}
+
+	struct core_t {
+		uint32_t              package_id;
+		std::vector<uint32_t> siblings; // logical cpus sharing this physical core
+	};
+
+	// Group logical cpus into physical cores - cpus are sorted by package and
+	// core already, so that siblings are adjacent.
+
+	std::vector<core_t> cores;
+	size_t              max_siblings = 0;
+
+	for ( auto it = topology->cpus.begin(); it != topology->cpus.end(); ++it ) {
+		if ( it == topology->cpus.begin() || it->package_id != ( it - 1 )->package_id || it->core_id != ( it - 1 )->core_id ) {
+			cores.push_back( { it->package_id, {} } );
+		}
+		cores.back().siblings.push_back( it->cpu );
+		max_siblings = std::max( max_siblings, cores.back().siblings.size() );
+	}
+
+	// Leave the first physical core to the main thread, if we can afford to.
+	if ( cores.size() > num_workers ) {
+		cores.erase( cores.begin() );
+	}
+
+	// Build a list of logical cpus in order of preference for the given policy.
+
+	std::vector<uint32_t> order;
+	order.reserve( topology->cpus.size() );
+
+	switch ( policy ) {
+	case CpuPlacementPolicy::ePhysicalCores:
+		for ( size_t s = 0; s != max_siblings; ++s ) {
+			for ( auto const &core : cores ) {
+				if ( s < core.siblings.size() ) {
+					order.push_back( core.siblings[ s ] );
+				}
+			}
+		}
+		break;
+	case CpuPlacementPolicy::eFillSocket:
+		for ( auto package_begin = cores.begin(); package_begin != cores.end(); ) {
+			auto package_end = std::find_if( package_begin, cores.end(), [ & ]( core_t const &c ) { return c.package_id != package_begin->package_id; } );
+			for ( size_t s = 0; s != max_siblings; ++s ) {
+				for ( auto core = package_begin; core != package_end; ++core ) {
+					if ( s < core->siblings.size() ) {
+						order.push_back( core->siblings[ s ] );
+					}
+				}
+			}
+			package_begin = package_end;
+		}
+		break;
+	case CpuPlacementPolicy::eSpread: {
+		// Split cores by package, then take turns between packages.
+		std::vector<std::vector<core_t const *>> packages;
+		for ( auto const &core : cores ) {
+			if ( packages.empty() || packages.back().front()->package_id != core.package_id ) {
+				packages.emplace_back();
+			}
+			packages.back().push_back( &core );
+		}
+		size_t max_cores_per_package = 0;
+		for ( auto const &p : packages ) {
+			max_cores_per_package = std::max( max_cores_per_package, p.size() );
+		}
+		for ( size_t s = 0; s != max_siblings; ++s ) {
+			for ( size_t i = 0; i != max_cores_per_package; ++i ) {
+				for ( auto const &p : packages ) {
+					if ( i < p.size() && s < p[ i ]->siblings.size() ) {
+						order.push_back( p[ i ]->siblings[ s ] );
+					}
+				}
+			}
+		}
+	} break;
+	}
+
+	for ( size_t i = 0; i != num_workers; ++i ) {
+		cpus[ i ] = order[ i % order.size() ];
+	}
+}
@@ -0,0 +1,52 @@
+#ifndef _CPU_TOPOLOGY_H_
+#define _CPU_TOPOLOGY_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+/* CPU topology, as far as it matters for placing worker threads.
+ *
+ * We only consider logical CPUs which this process may run on, as reported
+ * by `sched_getaffinity` - inside containers, or under `taskset`, this may
+ * be a small subset of the machine's CPUs. Topology information for each
+ * CPU is read from sysfs (`/sys/devices/system/cpu/cpuN/`). If sysfs is not
+ * available, each logical CPU is treated as a physical core on package 0.
+ */
+
+struct cpu_topology_cpu_t {
+	uint32_t cpu;        // logical cpu index, as used with CPU_SET
+	uint32_t core_id;    // physical core id, unique only within its package
+	uint32_t package_id; // socket
+	uint32_t numa_node;  // 0 if unknown
+};
+
+struct cpu_topology_t {
+	std::vector<cpu_topology_cpu_t> cpus; // sorted by package, core, then logical cpu index
+};
+
+// Worker placement policies - these mirror LeJobsPlacement in le_jobs.h
+enum class CpuPlacementPolicy : uint32_t {
+	ePhysicalCores = 0, // one worker per physical core, SMT siblings only once all cores are taken
+	eFillSocket,        // fill all logical cpus of a package before moving to the next package
+	eSpread,            // distribute workers round-robin across packages, one per physical core first
+};
+
+// Discover logical cpus available to this process. Returns false if the
+// process's cpu affinity mask could not be queried.
+bool cpu_topology_discover( cpu_topology_t *topology );
+
+// Choose logical cpus for `num_workers` worker threads following `policy`.
+//
+// The first physical core is left to the thread calling into the job
+// system (typically: the main thread), unless this would leave us with
+// fewer physical cores than worker threads.
+//
+// Writes one cpu index per worker into `cpus`. Once all available cpus have
+// been handed out, placement wraps around.
+void cpu_topology_place_workers( cpu_topology_t const *topology, CpuPlacementPolicy policy, size_t num_workers, uint32_t *cpus );
+
+// Returns the entry for logical cpu `cpu`, or nullptr if the cpu is not part of topology.
+cpu_topology_cpu_t const *cpu_topology_find( cpu_topology_t const *topology, uint32_t cpu );
+
+#endif
@@ -0,0 +1,138 @@
+#include "job_trace.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <dlfcn.h> // for dladdr
+
+// ----------------------------------------------------------------------
+
+job_trace_ring_t *job_trace_ring_create( uint32_t power_of_2_size ) {
+	assert( power_of_2_size && power_of_2_size < 32 );
+	const uint64_t          size          = uint64_t( 1 ) << power_of_2_size;
+	const size_t            required_size = sizeof( job_trace_ring_t ) + size * sizeof( job_trace_event_t );
+	job_trace_ring_t *const ret           = static_cast<job_trace_ring_t *>( calloc( 1, required_size ) );
+	if ( ret ) {
+		ret->power_of_2_mod = size - 1;
+	}
+	return ret;
+}
+
+// ----------------------------------------------------------------------
+
+void job_trace_ring_destroy( job_trace_ring_t *ring ) {
+	free( ring );
+}
+
+// ----------------------------------------------------------------------
+// Print a human-readable name for a job function: its symbol name if we
+// can find one, its address otherwise.
+static void write_function_name( FILE *file, uint64_t fun_addr ) {
+	Dl_info info{};
+	if ( dladdr( reinterpret_cast<void *>( fun_addr ), &info ) && info.dli_sname ) {
+		fprintf( file, "%s", info.dli_sname );
+	} else {
+		fprintf( file, "0x%lx", fun_addr );
+	}
+}
+
+// ----------------------------------------------------------------------
+
+bool job_trace_write_chrome_json( char const *file_path, job_trace_ring_t *const *rings, char const *const *thread_names, size_t num_rings, uint64_t tsc_origin, uint64_t steady_clock_origin_ns ) {
+
+	// Calibrate TSC against steady clock: we assume an invariant TSC, which
+	// is the case for any x86_64 cpu made within the last decade.
+
+	const uint64_t tsc_now          = __rdtsc();
+	const uint64_t steady_clock_now = uint64_t( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count() );
+
+	if ( tsc_now <= tsc_origin || steady_clock_now <= steady_clock_origin_ns ) {
+		return false;
+	}
+
+	const double ticks_per_us = double( tsc_now - tsc_origin ) / ( double( steady_clock_now - steady_clock_origin_ns ) / 1000.0 );
+
+	FILE *file = fopen( file_path, "wb" );
+
+	if ( nullptr == file ) {
+		return false;
+	}
+
+	fprintf( file, "{\"traceEvents\":[\n" );
+
+	bool is_first_event = true;
+
+	auto begin_event = [ & ]( char const *phase, size_t tid, uint64_t tsc ) {
+		fprintf( file, "%s{\"pid\":0,\"tid\":%zu,\"ph\":\"%s\",\"ts\":%.3f", is_first_event ? "" : ",\n", tid, phase, double( tsc - tsc_origin ) / ticks_per_us );
+		is_first_event = false;
+	};
+
+	for ( size_t tid = 0; tid != num_rings; ++tid ) {
+
+		job_trace_ring_t const *ring = rings[ tid ];
+
+		if ( nullptr == ring ) {
+			continue;
+		}
+
+		fprintf( file, "%s{\"pid\":0,\"tid\":%zu,\"ph\":\"M\",\"name\":\"thread_name\",\"args\":{\"name\":\"%s\"}}", is_first_event ? "" : ",\n", tid, thread_names[ tid ] );
+		is_first_event = false;
+
+		const uint64_t head     = ring->head.load();
+		const uint64_t capacity = ring->power_of_2_mod + 1;
+		const uint64_t start    = head > capacity ? head - capacity : 0;
+
+		for ( uint64_t i = start; i != head; ++i ) {
+
+			job_trace_event_t const &e = ring->events[ i & ring->power_of_2_mod ];
+
+			if ( e.tsc < tsc_origin ) {
+				// Event may have been overwritten while we were reading - skip.
+				continue;
+			}
+
+			switch ( e.type ) {
+			case JobTraceEvent::eJobBegin:
+				begin_event( "B", tid, e.tsc );
+				fprintf( file, ",\"cat\":\"job\",\"name\":\"" );
+				write_function_name( file, e.id );
+				fprintf( file, "\",\"args\":{\"fiber\":%u}}", e.fiber_idx );
+				break;
+			case JobTraceEvent::eFiberResume:
+				begin_event( "B", tid, e.tsc );
+				fprintf( file, ",\"cat\":\"job\",\"name\":\"" );
+				write_function_name( file, e.id );
+				fprintf( file, "\",\"args\":{\"fiber\":%u,\"resumed\":true}}", e.fiber_idx );
+				// fiber is no longer parked
+				begin_event( "e", tid, e.tsc );
+				fprintf( file, ",\"cat\":\"fiber\",\"name\":\"parked\",\"id\":%u}", e.fiber_idx );
+				break;
+			case JobTraceEvent::eJobEnd:
+				begin_event( "E", tid, e.tsc );
+				fprintf( file, "}" );
+				break;
+			case JobTraceEvent::eFiberYield:
+				begin_event( "E", tid, e.tsc );
+				fprintf( file, ",\"args\":{\"yield\":true}}" );
+				// fiber is parked on its worker's wait list until it resumes
+				begin_event( "b", tid, e.tsc );
+				fprintf( file, ",\"cat\":\"fiber\",\"name\":\"parked\",\"id\":%u}", e.fiber_idx );
+				break;
+			case JobTraceEvent::eCounterWaitBegin:
+				begin_event( "i", tid, e.tsc );
+				fprintf( file, ",\"s\":\"t\",\"cat\":\"counter\",\"name\":\"wait for counter\",\"args\":{\"counter\":\"0x%lx\"}}", e.id );
+				break;
+			case JobTraceEvent::eCounterWaitEnd:
+				begin_event( "i", tid, e.tsc );
+				fprintf( file, ",\"s\":\"t\",\"cat\":\"counter\",\"name\":\"counter reached\",\"args\":{\"counter\":\"0x%lx\"}}", e.id );
+				break;
+			}
+		}
+	}
+
+	fprintf( file, "\n]}\n" );
+	fclose( file );
+
+	return true;
+}
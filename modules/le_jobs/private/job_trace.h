@@ -0,0 +1,61 @@
+#ifndef _JOB_TRACE_H_
+#define _JOB_TRACE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include <x86intrin.h> // for __rdtsc
+
+/* Event rings for tracing the job system.
+ *
+ * Each worker thread records into its own ring, which means that recording
+ * does not contend. Rings have a fixed capacity - once a ring is full, new
+ * events overwrite the oldest events.
+ *
+ * Events carry raw TSC timestamps; these are converted to microseconds when
+ * rings are written out as Chrome `trace_event` JSON, which you can load via
+ * `chrome://tracing`, or <https://ui.perfetto.dev>.
+ */
+
+enum class JobTraceEvent : uint32_t {
+	eJobBegin = 0,     // a fiber starts executing a new job, id: job function
+	eJobEnd,           // job completed, id: job function
+	eFiberYield,       // fiber yielded back to its worker thread, id: job function
+	eFiberResume,      // fiber resumed after yield, id: job function
+	eCounterWaitBegin, // started waiting for counter, id: counter
+	eCounterWaitEnd,   // counter reached target, id: counter
+};
+
+struct job_trace_event_t {
+	uint64_t      tsc;       // timestamp counter at time of recording
+	uint64_t      id;        // job function, or counter address, depending on type
+	JobTraceEvent type;      //
+	uint32_t      fiber_idx; // index of fiber in fiber pool, if applicable
+};
+
+struct job_trace_ring_t {
+	std::atomic<uint64_t> head;
+	uint64_t              power_of_2_mod;
+	// events must be last - they spill outside of this struct
+	job_trace_event_t events[];
+};
+
+job_trace_ring_t *job_trace_ring_create( uint32_t power_of_2_size );
+void              job_trace_ring_destroy( job_trace_ring_t *ring );
+
+// Record an event into ring. This may be called from any thread, but
+// is cheapest if only one thread records into any given ring.
+inline void job_trace_ring_record( job_trace_ring_t *ring, JobTraceEvent type, uint64_t id, uint32_t fiber_idx ) {
+	const uint64_t pos                         = ring->head.fetch_add( 1, std::memory_order_relaxed );
+	ring->events[ pos & ring->power_of_2_mod ] = { __rdtsc(), id, type, fiber_idx };
+}
+
+// Write all events in rings to a file in Chrome `trace_event` JSON format.
+//
+// `tsc_origin` and `steady_clock_origin_ns` must have been sampled at the same time,
+// and are used to calibrate the conversion of TSC ticks into microseconds.
+//
+// Returns false if file could not be written.
+bool job_trace_write_chrome_json( char const *file_path, job_trace_ring_t *const *rings, char const *const *thread_names, size_t num_rings, uint64_t tsc_origin, uint64_t steady_clock_origin_ns );
+
+#endif
@@ -0,0 +1,163 @@
+#include "lockfree_mpmc_queue.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <new>
+#include <thread>
+
+/* Implementation follows Dmitry Vyukov's bounded MPMC queue:
+ * <https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue>
+ *
+ * Each cell carries a sequence number which tells producers and consumers
+ * whether the cell is ready to be written to, or read from. Claiming a cell
+ * gives exclusive access to its payload, which is why we may copy payloads
+ * without further synchronisation.
+ */
+
+struct lockfree_mpmc_cell_t {
+	std::atomic<uint64_t> sequence;
+	// payload follows - it spills outside of this struct
+};
+
+struct lockfree_mpmc_queue_t {
+	std::atomic<uint64_t> enqueue_pos;
+	char                  _cache_padding1[ 64 - sizeof( std::atomic<uint64_t> ) ];
+	std::atomic<uint64_t> dequeue_pos;
+	char                  _cache_padding2[ 64 - sizeof( std::atomic<uint64_t> ) ];
+	uint64_t              power_of_2_mod;
+	uint32_t              element_size;
+	uint32_t              cell_stride; // size of cell header + payload, rounded up to 8 bytes
+	// cells must be last - they spill outside of this struct
+	alignas( 8 ) char cells[];
+};
+
+// ----------------------------------------------------------------------
+
+static inline lockfree_mpmc_cell_t *get_cell( lockfree_mpmc_queue_t *q, uint64_t pos ) {
+	return reinterpret_cast<lockfree_mpmc_cell_t *>( q->cells + ( pos & q->power_of_2_mod ) * q->cell_stride );
+}
+
+// ----------------------------------------------------------------------
+
+static inline char *get_payload( lockfree_mpmc_cell_t *cell ) {
+	return reinterpret_cast<char *>( cell ) + sizeof( lockfree_mpmc_cell_t );
+}
+
+// ----------------------------------------------------------------------
+
+lockfree_mpmc_queue_t *lockfree_mpmc_queue_create( uint32_t power_of_2_size, uint32_t element_size ) {
+	assert( power_of_2_size && power_of_2_size < 32 );
+	assert( element_size );
+
+	const uint64_t size          = uint64_t( 1 ) << power_of_2_size;
+	const uint32_t cell_stride   = ( sizeof( lockfree_mpmc_cell_t ) + element_size + 7 ) & ~uint32_t( 7 );
+	const size_t   required_size = sizeof( lockfree_mpmc_queue_t ) + size * cell_stride;
+
+	lockfree_mpmc_queue_t *const ret = static_cast<lockfree_mpmc_queue_t *>( calloc( 1, required_size ) );
+
+	if ( ret ) {
+		ret->power_of_2_mod = size - 1;
+		ret->element_size   = element_size;
+		ret->cell_stride    = cell_stride;
+		for ( uint64_t i = 0; i != size; ++i ) {
+			new ( &get_cell( ret, i )->sequence ) std::atomic<uint64_t>( i );
+		}
+	}
+
+	return ret;
+}
+
+// ----------------------------------------------------------------------
+
+void lockfree_mpmc_queue_destroy( lockfree_mpmc_queue_t *q ) {
+	free( q );
+}
+
+// ----------------------------------------------------------------------
+
+size_t lockfree_mpmc_queue_size( const lockfree_mpmc_queue_t *q ) {
+	assert( q );
+	// read dequeue_pos first; make it look less than or equal to its actual size
+	const uint64_t low  = q->dequeue_pos.load( std::memory_order_relaxed );
+	const uint64_t high = q->enqueue_pos.load( std::memory_order_relaxed );
+	return high > low ? size_t( high - low ) : 0;
+}
+
+// ----------------------------------------------------------------------
+
+int lockfree_mpmc_queue_trypush( lockfree_mpmc_queue_t *q, void const *in ) {
+	assert( q );
+	assert( in );
+
+	lockfree_mpmc_cell_t *cell;
+	uint64_t              pos = q->enqueue_pos.load( std::memory_order_relaxed );
+
+	for ( ;; ) {
+		cell                = get_cell( q, pos );
+		const uint64_t seq  = cell->sequence.load( std::memory_order_acquire );
+		const int64_t  diff = int64_t( seq ) - int64_t( pos );
+
+		if ( diff == 0 ) {
+			// cell is free for writing - try to claim it.
+			if ( q->enqueue_pos.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) ) {
+				break;
+			}
+		} else if ( diff < 0 ) {
+			// cell still holds an element from the previous lap: queue is full.
+			return 0;
+		} else {
+			// another producer claimed this cell before us.
+			pos = q->enqueue_pos.load( std::memory_order_relaxed );
+		}
+	}
+
+	memcpy( get_payload( cell ), in, q->element_size );
+	cell->sequence.store( pos + 1, std::memory_order_release );
+
+	return 1;
+}
+
+// ----------------------------------------------------------------------
+
+void lockfree_mpmc_queue_push( lockfree_mpmc_queue_t *q, void const *in ) {
+	while ( !lockfree_mpmc_queue_trypush( q, in ) ) {
+		// the queue is full - give consumers a chance to catch up.
+		std::this_thread::yield();
+	}
+}
+
+// ----------------------------------------------------------------------
+
+int lockfree_mpmc_queue_trypop( lockfree_mpmc_queue_t *q, void *out ) {
+	assert( q );
+	assert( out );
+
+	lockfree_mpmc_cell_t *cell;
+	uint64_t              pos = q->dequeue_pos.load( std::memory_order_relaxed );
+
+	for ( ;; ) {
+		cell                = get_cell( q, pos );
+		const uint64_t seq  = cell->sequence.load( std::memory_order_acquire );
+		const int64_t  diff = int64_t( seq ) - int64_t( pos + 1 );
+
+		if ( diff == 0 ) {
+			// cell holds an element - try to claim it.
+			if ( q->dequeue_pos.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) ) {
+				break;
+			}
+		} else if ( diff < 0 ) {
+			// cell has not been written to yet: queue is empty.
+			return 0;
+		} else {
+			// another consumer claimed this cell before us.
+			pos = q->dequeue_pos.load( std::memory_order_relaxed );
+		}
+	}
+
+	memcpy( out, get_payload( cell ), q->element_size );
+	cell->sequence.store( pos + q->power_of_2_mod + 1, std::memory_order_release );
+
+	return 1;
+}
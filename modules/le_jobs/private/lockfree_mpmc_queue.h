@@ -0,0 +1,23 @@
+#ifndef _LOCKFREE_MPMC_QUEUE_H_
+#define _LOCKFREE_MPMC_QUEUE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* Bounded multi-producer, multi-consumer FIFO queue.
+ *
+ * Elements are stored in-place, and copied in and out of the queue, which
+ * means that pushing and popping never allocates. Elements must be trivially
+ * copyable.
+ */
+
+struct lockfree_mpmc_queue_t;
+
+lockfree_mpmc_queue_t *lockfree_mpmc_queue_create( uint32_t power_of_2_size, uint32_t element_size );
+void                   lockfree_mpmc_queue_destroy( lockfree_mpmc_queue_t *q );
+size_t                 lockfree_mpmc_queue_size( const lockfree_mpmc_queue_t *q );
+int                    lockfree_mpmc_queue_trypush( lockfree_mpmc_queue_t *q, void const *in ); // returns 0 if queue is full
+void                   lockfree_mpmc_queue_push( lockfree_mpmc_queue_t *q, void const *in );    // spins until there is space in the queue
+int                    lockfree_mpmc_queue_trypop( lockfree_mpmc_queue_t *q, void *out );       // returns 0 if queue is empty
+
+#endif
@@ -0,0 +1,166 @@
+#include "work_stealing_deque.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+
+/* Implementation follows:
+ *
+ * Lê, Pop, Cohen, Zappa Nardelli: "Correct and Efficient Work-Stealing for
+ * Weak Memory Models", PPoPP 2013, which gives a C11 memory-model mapping of
+ * the original Chase-Lev deque.
+ *
+ * We don't grow the buffer - if the deque is full, `trypush` fails, and the
+ * caller is expected to fall back to a shared queue.
+ *
+ * Elements are stored in-place as a sequence of 64 bit words. A thief may read
+ * an element while the owner overwrites it - but only if the slot has already
+ * been taken by somebody else, in which case the thief's CAS on `top` fails,
+ * and the thief discards what it read. We access words atomically so that
+ * this benign race does not become undefined behaviour.
+ */
+
+using word_t = uint64_t;
+
+struct work_stealing_deque_t {
+	// top is written by thieves, bottom only by the owner: keep them on separate cache lines.
+	std::atomic<int64_t> top;
+	char                 _cache_padding1[ 64 - sizeof( std::atomic<int64_t> ) ];
+	std::atomic<int64_t> bottom;
+	char                 _cache_padding2[ 64 - sizeof( std::atomic<int64_t> ) ];
+	int64_t              size;
+	int64_t              power_of_2_mod;
+	uint32_t             words_per_element;
+	// buffer must be last - it spills outside of this struct
+	std::atomic<word_t> buffer[];
+};
+
+// ----------------------------------------------------------------------
+
+static inline void element_store( work_stealing_deque_t *dq, int64_t index, void const *in ) {
+	std::atomic<word_t> *slot = dq->buffer + ( index & dq->power_of_2_mod ) * dq->words_per_element;
+	char const *         src  = static_cast<char const *>( in );
+	for ( uint32_t i = 0; i != dq->words_per_element; ++i, src += sizeof( word_t ) ) {
+		word_t w;
+		memcpy( &w, src, sizeof( word_t ) );
+		slot[ i ].store( w, std::memory_order_relaxed );
+	}
+}
+
+// ----------------------------------------------------------------------
+
+static inline void element_load( work_stealing_deque_t *dq, int64_t index, void *out ) {
+	std::atomic<word_t> const *slot = dq->buffer + ( index & dq->power_of_2_mod ) * dq->words_per_element;
+	char *                     dst  = static_cast<char *>( out );
+	for ( uint32_t i = 0; i != dq->words_per_element; ++i, dst += sizeof( word_t ) ) {
+		word_t w = slot[ i ].load( std::memory_order_relaxed );
+		memcpy( dst, &w, sizeof( word_t ) );
+	}
+}
+
+// ----------------------------------------------------------------------
+
+work_stealing_deque_t *work_stealing_deque_create( uint32_t power_of_2_size, uint32_t element_size ) {
+	assert( power_of_2_size && power_of_2_size < 32 );
+	assert( element_size && element_size % sizeof( word_t ) == 0 );
+	const int64_t                size              = int64_t( 1 ) << power_of_2_size;
+	const uint32_t               words_per_element = element_size / sizeof( word_t );
+	const size_t                 required_size     = sizeof( work_stealing_deque_t ) + size * words_per_element * sizeof( std::atomic<word_t> );
+	work_stealing_deque_t *const ret               = static_cast<work_stealing_deque_t *>( calloc( 1, required_size ) );
+	if ( ret ) {
+		ret->size              = size;
+		ret->power_of_2_mod    = size - 1;
+		ret->words_per_element = words_per_element;
+	}
+	return ret;
+}
+
+// ----------------------------------------------------------------------
+
+void work_stealing_deque_destroy( work_stealing_deque_t *dq ) {
+	free( dq );
+}
+
+// ----------------------------------------------------------------------
+
+size_t work_stealing_deque_size( const work_stealing_deque_t *dq ) {
+	assert( dq );
+	const int64_t b = dq->bottom.load( std::memory_order_relaxed );
+	const int64_t t = dq->top.load( std::memory_order_relaxed );
+	return b > t ? size_t( b - t ) : 0;
+}
+
+// ----------------------------------------------------------------------
+
+int work_stealing_deque_trypush( work_stealing_deque_t *dq, void const *in ) {
+	assert( dq );
+	assert( in );
+
+	const int64_t b = dq->bottom.load( std::memory_order_relaxed );
+	const int64_t t = dq->top.load( std::memory_order_acquire );
+
+	if ( b - t > dq->size - 1 ) {
+		// deque is full
+		return 0;
+	}
+
+	element_store( dq, b, in );
+	std::atomic_thread_fence( std::memory_order_release );
+	dq->bottom.store( b + 1, std::memory_order_relaxed );
+
+	return 1;
+}
+
+// ----------------------------------------------------------------------
+
+int work_stealing_deque_pop( work_stealing_deque_t *dq, void *out ) {
+	assert( dq );
+
+	const int64_t b = dq->bottom.load( std::memory_order_relaxed ) - 1;
+	dq->bottom.store( b, std::memory_order_relaxed );
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	int64_t t = dq->top.load( std::memory_order_relaxed );
+
+	int ret = 0;
+
+	if ( t <= b ) {
+		// deque was not empty
+		element_load( dq, b, out );
+		ret = 1;
+		if ( t == b ) {
+			// this was the last element - we must race any thieves for it.
+			if ( !dq->top.compare_exchange_strong( t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) ) {
+				// a thief got there first.
+				ret = 0;
+			}
+			dq->bottom.store( b + 1, std::memory_order_relaxed );
+		}
+	} else {
+		// deque was empty - restore bottom.
+		dq->bottom.store( b + 1, std::memory_order_relaxed );
+	}
+
+	return ret;
+}
+
+// ----------------------------------------------------------------------
+
+int work_stealing_deque_steal( work_stealing_deque_t *dq, void *out ) {
+	assert( dq );
+
+	int64_t t = dq->top.load( std::memory_order_acquire );
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	const int64_t b = dq->bottom.load( std::memory_order_acquire );
+
+	if ( t < b ) {
+		element_load( dq, t, out );
+		if ( !dq->top.compare_exchange_strong( t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) ) {
+			// lost race against another thief, or the owner.
+			return 0;
+		}
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,26 @@
+#ifndef _WORK_STEALING_DEQUE_H_
+#define _WORK_STEALING_DEQUE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* Fixed-capacity Chase-Lev work-stealing deque.
+ *
+ * Only the thread owning the deque may call `push` and `pop` - these operate
+ * on the bottom end of the deque (LIFO). Any thread may call `steal`, which
+ * takes elements from the top end of the deque (FIFO).
+ *
+ * Elements are stored in-place, and copied in and out of the deque. Element
+ * size must be a multiple of 8 bytes, and elements must be trivially copyable.
+ */
+
+struct work_stealing_deque_t;
+
+work_stealing_deque_t *work_stealing_deque_create( uint32_t power_of_2_size, uint32_t element_size );
+void                   work_stealing_deque_destroy( work_stealing_deque_t *dq );
+size_t                 work_stealing_deque_size( const work_stealing_deque_t *dq );
+int                    work_stealing_deque_trypush( work_stealing_deque_t *dq, void const *in ); // owner only; returns 0 if deque is full
+int                    work_stealing_deque_pop( work_stealing_deque_t *dq, void *out );          // owner only; returns 0 if deque is empty
+int                    work_stealing_deque_steal( work_stealing_deque_t *dq, void *out );        // any thread; returns 0 if deque is empty or on lost race
+
+#endif
@@ -11,6 +11,7 @@
 #include <assert.h>
 #include <vector>
 #include <algorithm>
+#include <mutex>
 
 #ifndef LE_MT
 #	define LE_MT 0
@@ -20,6 +21,11 @@
 #	include "le_jobs/le_jobs.h"
 #endif
 
+#ifndef LE_ENCODER_ELIDE_REDUNDANT_STATE
+// Whether encoders drop binds and state sets which would not change the current state.
+#	define LE_ENCODER_ELIDE_REDUNDANT_STATE 1
+#endif
+
 // ----------------------------------------------------------------------
 // return allocator offset based on current worker thread index.
 static inline int fetch_allocator_index() {
@@ -41,7 +47,11 @@ static inline le_allocator_o *fetch_allocator( le_allocator_o **ppAlloc ) {
 
 // ----------------------------------------------------------------------
 
-#define EMPLACE_CMD( x ) new ( &self->mCommandStream[ 0 ] + self->mCommandStreamSize )( x )
+// Place command `x` into the command stream, with room for `payload_size` bytes of
+// inline data directly following the command. This does not yet commit the command:
+// callers must still increase mCommandStreamSize by the command's size.
+#define EMPLACE_CMD_WITH_PAYLOAD( x, payload_size ) new ( cbe_command_stream_reserve( self, sizeof( x ) + ( payload_size ) ) )( x )
+#define EMPLACE_CMD( x )                            EMPLACE_CMD_WITH_PAYLOAD( x, 0 )
 
 // ----------------------------------------------------------------------
 
@@ -70,21 +80,278 @@ struct le_shader_binding_table_o {
 
 // ----------------------------------------------------------------------
 
+// Command streams are stored in a list of chunks. Chunks are recycled via a pool,
+// together with encoders, so that recording a frame does not allocate once the
+// pool has warmed up. A command never straddles two chunks - commands which are
+// larger than a standard chunk get a chunk of their own.
+constexpr size_t COMMAND_STREAM_CHUNK_SIZE = 4096 * 16; // 16 pages of memory = 64KB
+
+struct command_stream_chunk_t {
+	size_t capacity; // number of bytes available in data
+	// data must be last - it spills outside of this struct
+	alignas( 16 ) char data[];
+};
+
+// State set by commands recorded so far - we use this to drop binds and state
+// sets which would not change the current state.
+//
+// Binding a pipeline which differs from the current pipeline invalidates argument
+// state (the backend rebuilds argument state to match the new pipeline's layout),
+// as well as viewport and scissor state (which may not be dynamic for the new pipeline).
+enum class le_encoder_argument_kind : uint32_t {
+	eBuffer,  // bound via bind_argument_buffer: value is buffer id, offset, range
+	eData,    // set via set_argument_data: value is argument data
+	eTexture, // value is texture handle
+	eImage,   // value is image id
+	eTlas,    // value is tlas id
+};
+
+struct le_encoder_argument_state_t {
+	uint64_t                 argument_name_id;
+	uint64_t                 array_index;
+	le_encoder_argument_kind kind;
+	std::vector<char>        value;    // current value for argument, as bytes
+	bool                     is_valid; // invalid entries are kept so that we can recycle their memory
+};
+
+struct le_encoder_vertex_binding_state_t {
+	le_resource_handle_t buffer;
+	uint64_t             offset;
+	bool                 is_valid;
+};
+
+struct le_encoder_state_t {
+	le::CommandType pipeline_type = {};      // type of command which bound current pipeline
+	void const *    pipeline      = nullptr; // current pipeline handle, nullptr if unknown
+
+	uint32_t                  first_viewport = 0;
+	std::vector<le::Viewport> viewports; // empty if unknown
+	uint32_t                  first_scissor = 0;
+	std::vector<le::Rect2D>   scissors; // empty if unknown
+
+	std::vector<le_encoder_vertex_binding_state_t> vertex_bindings; // indexed by binding number
+	le::CommandBindIndexBuffer                     index_buffer{};
+	bool                                           has_index_buffer = false;
+
+	std::vector<le_encoder_argument_state_t> arguments;
+};
+
 struct le_command_buffer_encoder_o {
-	char                                     mCommandStream[ 4096 * 512 ]; // 512 pages of memory = 2MB
-	size_t                                   mCommandStreamSize = 0;
-	size_t                                   mCommandCount      = 0;
-	le_allocator_o **                        ppAllocator        = nullptr; // allocator list is owned by backend, externally
-	le_pipeline_manager_o *                  pipelineManager    = nullptr;
-	le_staging_allocator_o *                 stagingAllocator   = nullptr; // Borrowed from backend - used for larger, permanent resources, shared amongst encoders
-	le::Extent2D                             extent             = {};      // Renderpass extent, otherwise swapchain extent inferred via renderer, this may be queried by users of encoder.
-	std::vector<le_shader_binding_table_o *> shader_binding_tables;        // owning
+	std::vector<command_stream_chunk_t *>    mChunks;                       // owning, chunks holding the command stream, in order
+	size_t                                   mChunkStreamBegin   = 0;       // stream offset (in bytes, as counted by mCommandStreamSize) at which the last chunk begins
+	size_t                                   mCommandStreamSize  = 0;       // number of bytes in stream, not counting jump commands between chunks
+	size_t                                   mCommandCount       = 0;       //
+	le_allocator_o **                        ppAllocator         = nullptr; // allocator list is owned by backend, externally
+	le_pipeline_manager_o *                  pipelineManager     = nullptr;
+	le_staging_allocator_o *                 stagingAllocator    = nullptr; // Borrowed from backend - used for larger, permanent resources, shared amongst encoders
+	le::Extent2D                             extent              = {};      // Renderpass extent, otherwise swapchain extent inferred via renderer, this may be queried by users of encoder.
+	std::vector<le_shader_binding_table_o *> shader_binding_tables;         // owning
+	le_encoder_state_t                       state;                         // state set by commands recorded so far
+	size_t                                   mCommandsElided = 0;           // number of commands which were dropped because they would not have changed state
 };
 
+// ----------------------------------------------------------------------
+// Pool of idle encoders, and idle standard-size command stream chunks.
+//
+// Encoders are created and destroyed on different threads (recording, and
+// backend frame clear), and chunks are acquired while recording, which may
+// happen on any worker thread - which is why the pool is protected by a mutex.
+struct encoder_pool_t {
+	std::mutex                                 mtx;
+	std::vector<le_command_buffer_encoder_o *> encoders; // idle encoders, ready for recycling
+	std::vector<command_stream_chunk_t *>      chunks;   // idle chunks, all of size COMMAND_STREAM_CHUNK_SIZE
+
+	~encoder_pool_t() {
+		for ( auto e : encoders ) {
+			delete e;
+		}
+		for ( auto c : chunks ) {
+			free( c );
+		}
+	}
+};
+
+static encoder_pool_t encoder_pool{};
+
+// ----------------------------------------------------------------------
+// Return a chunk which can hold at least `min_capacity` bytes.
+static command_stream_chunk_t *command_stream_chunk_acquire( size_t min_capacity ) {
+
+	if ( min_capacity <= COMMAND_STREAM_CHUNK_SIZE ) {
+		{
+			std::scoped_lock lock( encoder_pool.mtx );
+			if ( !encoder_pool.chunks.empty() ) {
+				auto chunk = encoder_pool.chunks.back();
+				encoder_pool.chunks.pop_back();
+				return chunk;
+			}
+		}
+		min_capacity = COMMAND_STREAM_CHUNK_SIZE;
+	}
+
+	auto chunk = static_cast<command_stream_chunk_t *>( malloc( sizeof( command_stream_chunk_t ) + min_capacity ) );
+	assert( chunk && "Could not allocate command stream chunk." );
+	chunk->capacity = min_capacity;
+	return chunk;
+}
+
+// ----------------------------------------------------------------------
+// Return chunks to pool - oversized chunks are freed.
+static void command_stream_chunks_release( command_stream_chunk_t *const *chunks, size_t num_chunks ) {
+	std::scoped_lock lock( encoder_pool.mtx );
+	for ( auto c = chunks; c != chunks + num_chunks; c++ ) {
+		if ( ( *c )->capacity == COMMAND_STREAM_CHUNK_SIZE ) {
+			encoder_pool.chunks.push_back( *c );
+		} else {
+			free( *c );
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+// Return address at which to place a command of `num_bytes` bytes, including
+// its payload. If the command does not fit into the current chunk, we continue
+// the command stream in a new chunk.
+//
+// We always keep enough space at the end of a chunk for a jump command,
+// so that we can link to the next chunk.
+static void *cbe_command_stream_reserve( le_command_buffer_encoder_o *self, size_t num_bytes ) {
+
+	assert( num_bytes <= UINT32_MAX && "command too large - command size must fit into command header" );
+
+	const size_t required_bytes = num_bytes + sizeof( le::CommandJump );
+	const size_t chunk_offset   = self->mCommandStreamSize - self->mChunkStreamBegin;
+
+	command_stream_chunk_t *chunk = self->mChunks.empty() ? nullptr : self->mChunks.back();
+
+	if ( chunk && chunk_offset + required_bytes <= chunk->capacity ) {
+		return chunk->data + chunk_offset;
+	}
+
+	// ----------| invariant: command does not fit into current chunk, or there is no current chunk.
+
+	command_stream_chunk_t *next_chunk = command_stream_chunk_acquire( required_bytes );
+
+	if ( chunk ) {
+		auto cmd       = new ( chunk->data + chunk_offset ) le::CommandJump;
+		cmd->info.next = next_chunk->data;
+	}
+
+	self->mChunks.push_back( next_chunk );
+	self->mChunkStreamBegin = self->mCommandStreamSize;
+
+	return next_chunk->data;
+}
+
+// ----------------------------------------------------------------------
+// Forget all state - no subsequent binds or state sets will be elided until
+// they have been recorded at least once.
+static void cbe_state_reset( le_encoder_state_t &state ) {
+	state.pipeline = nullptr;
+	state.viewports.clear();
+	state.scissors.clear();
+	state.vertex_bindings.clear();
+	state.has_index_buffer = false;
+	for ( auto &a : state.arguments ) {
+		a.is_valid = false;
+	}
+}
+
+// ----------------------------------------------------------------------
+// Returns true if binding `pipeline` would not change state, in which case
+// the bind command must not be recorded. Otherwise, updates state.
+// A `pipeline` of nullptr is never redundant.
+static bool cbe_state_bind_pipeline( le_command_buffer_encoder_o *self, le::CommandType type, void const *pipeline ) {
+#if ( LE_ENCODER_ELIDE_REDUNDANT_STATE )
+	auto &state = self->state;
+
+	if ( pipeline && state.pipeline == pipeline && state.pipeline_type == type ) {
+		self->mCommandsElided++;
+		return true;
+	}
+
+	// Vertex and index buffer bindings survive pipeline binds - everything
+	// else depends on the pipeline, and must be set again.
+	state.viewports.clear();
+	state.scissors.clear();
+	for ( auto &a : state.arguments ) {
+		a.is_valid = false;
+	}
+
+	state.pipeline_type = type;
+	state.pipeline      = pipeline;
+#endif
+	return false;
+}
+
+// ----------------------------------------------------------------------
+// Returns true if setting argument to `value` would not change state, in which
+// case the command must not be recorded. Otherwise, updates state.
+static bool cbe_state_set_argument( le_command_buffer_encoder_o *self, le_encoder_argument_kind kind, uint64_t argument_name_id, uint64_t array_index, void const *value, size_t num_bytes ) {
+#if ( LE_ENCODER_ELIDE_REDUNDANT_STATE )
+	le_encoder_argument_state_t *current  = nullptr; // entry holding current value for argument
+	le_encoder_argument_state_t *recycled = nullptr; // first invalid entry
+
+	for ( auto &a : self->state.arguments ) {
+		if ( !a.is_valid ) {
+			recycled = recycled ? recycled : &a;
+		} else if ( a.argument_name_id == argument_name_id && a.array_index == array_index ) {
+			current = &a;
+			break;
+		}
+	}
+
+	if ( current && current->kind == kind &&
+	     current->value.size() == num_bytes &&
+	     0 == memcmp( current->value.data(), value, num_bytes ) ) {
+		self->mCommandsElided++;
+		return true;
+	}
+
+	if ( current == nullptr ) {
+		current = recycled ? recycled : &self->state.arguments.emplace_back();
+	}
+
+	auto bytes = static_cast<char const *>( value );
+
+	current->argument_name_id = argument_name_id;
+	current->array_index      = array_index;
+	current->kind             = kind;
+	current->value.assign( bytes, bytes + num_bytes );
+	current->is_valid = true;
+#endif
+	return false;
+}
+
+// ----------------------------------------------------------------------
+// Forget current value for argument - use this if setting an argument failed.
+static void cbe_state_forget_argument( le_command_buffer_encoder_o *self, uint64_t argument_name_id, uint64_t array_index ) {
+	for ( auto &a : self->state.arguments ) {
+		if ( a.argument_name_id == argument_name_id && a.array_index == array_index ) {
+			a.is_valid = false;
+		}
+	}
+}
+
 // ----------------------------------------------------------------------
 
 static le_command_buffer_encoder_o *cbe_create( le_allocator_o **allocator, le_pipeline_manager_o *pipelineManager, le_staging_allocator_o *stagingAllocator, le::Extent2D const &extent = {} ) {
-	auto self              = new le_command_buffer_encoder_o;
+
+	le_command_buffer_encoder_o *self = nullptr;
+
+	{
+		// Recycle an idle encoder, if there is one.
+		std::scoped_lock lock( encoder_pool.mtx );
+		if ( !encoder_pool.encoders.empty() ) {
+			self = encoder_pool.encoders.back();
+			encoder_pool.encoders.pop_back();
+		}
+	}
+
+	if ( self == nullptr ) {
+		self = new le_command_buffer_encoder_o;
+	}
+
 	self->ppAllocator      = allocator;
 	self->pipelineManager  = pipelineManager;
 	self->stagingAllocator = stagingAllocator;
@@ -104,7 +371,24 @@ static void cbe_destroy( le_command_buffer_encoder_o *self ) {
 		delete ( sbt );
 	}
 
-	delete ( self );
+	command_stream_chunks_release( self->mChunks.data(), self->mChunks.size() );
+
+	// Reset encoder, so that it may be recycled - vectors keep their capacity.
+
+	self->mChunks.clear();
+	self->shader_binding_tables.clear();
+	cbe_state_reset( self->state );
+	self->mCommandsElided    = 0;
+	self->mChunkStreamBegin  = 0;
+	self->mCommandStreamSize = 0;
+	self->mCommandCount      = 0;
+	self->ppAllocator        = nullptr;
+	self->pipelineManager    = nullptr;
+	self->stagingAllocator   = nullptr;
+	self->extent             = {};
+
+	std::scoped_lock lock( encoder_pool.mtx );
+	encoder_pool.encoders.push_back( self );
 }
 
 // ----------------------------------------------------------------------
@@ -200,12 +484,28 @@ static void cbe_set_viewport( le_command_buffer_encoder_o *self,
                               const uint32_t               viewportCount,
                               const le::Viewport *         pViewports ) {
 
-	auto cmd = EMPLACE_CMD( le::CommandSetViewport ); // placement new!
+#if ( LE_ENCODER_ELIDE_REDUNDANT_STATE )
+	{
+		auto &state = self->state;
+		if ( !state.viewports.empty() &&
+		     state.first_viewport == firstViewport &&
+		     state.viewports.size() == viewportCount &&
+		     0 == memcmp( state.viewports.data(), pViewports, sizeof( le::Viewport ) * viewportCount ) ) {
+			self->mCommandsElided++;
+			return;
+		}
+		state.first_viewport = firstViewport;
+		state.viewports.assign( pViewports, pViewports + viewportCount );
+	}
+#endif
+
+	size_t dataSize = sizeof( le::Viewport ) * viewportCount;
+
+	auto cmd = EMPLACE_CMD_WITH_PAYLOAD( le::CommandSetViewport, dataSize ); // placement new!
 
 	// We point data to the next available position in the data stream
 	// so that we can store the data for viewports inline.
-	void * data     = ( cmd + 1 ); // note: this increments a le::CommandSetViewport pointer by one time its object size, then gets the address
-	size_t dataSize = sizeof( le::Viewport ) * viewportCount;
+	void *data = ( cmd + 1 ); // note: this increments a le::CommandSetViewport pointer by one time its object size, then gets the address
 
 	cmd->info = { firstViewport, viewportCount };
 	cmd->header.info.size += dataSize; // we must increase the size of this command by its payload size
@@ -244,12 +544,28 @@ static void cbe_set_scissor( le_command_buffer_encoder_o *self,
                              const uint32_t               scissorCount,
                              le::Rect2D const *           pScissors ) {
 
-	auto cmd = EMPLACE_CMD( le::CommandSetScissor ); // placement new!
+#if ( LE_ENCODER_ELIDE_REDUNDANT_STATE )
+	{
+		auto &state = self->state;
+		if ( !state.scissors.empty() &&
+		     state.first_scissor == firstScissor &&
+		     state.scissors.size() == scissorCount &&
+		     0 == memcmp( state.scissors.data(), pScissors, sizeof( le::Rect2D ) * scissorCount ) ) {
+			self->mCommandsElided++;
+			return;
+		}
+		state.first_scissor = firstScissor;
+		state.scissors.assign( pScissors, pScissors + scissorCount );
+	}
+#endif
+
+	size_t dataSize = sizeof( le::Rect2D ) * scissorCount;
+
+	auto cmd = EMPLACE_CMD_WITH_PAYLOAD( le::CommandSetScissor, dataSize ); // placement new!
 
 	// We point to the next available position in the data stream
 	// so that we can store the data for scissors inline.
-	void * data     = ( cmd + 1 );
-	size_t dataSize = sizeof( le::Rect2D ) * scissorCount;
+	void *data = ( cmd + 1 );
 
 	cmd->info = { firstScissor, scissorCount };
 	cmd->header.info.size += dataSize; // we must increase the size of this command by its payload size
@@ -272,11 +588,36 @@ static void cbe_bind_vertex_buffers( le_command_buffer_encoder_o *self,
 	// in the backend to actual vulkan buffer ids.
 	// Buffer must be annotated whether it is transient or not
 
-	auto cmd = EMPLACE_CMD( le::CommandBindVertexBuffers ); // placement new!
+#if ( LE_ENCODER_ELIDE_REDUNDANT_STATE )
+	{
+		auto &bindings     = self->state.vertex_bindings;
+		bool  is_redundant = bindingCount > 0 && firstBinding + bindingCount <= bindings.size();
+
+		for ( uint32_t i = 0; is_redundant && i != bindingCount; i++ ) {
+			auto const &b = bindings[ firstBinding + i ];
+			is_redundant  = b.is_valid && b.buffer == pBuffers[ i ] && b.offset == pOffsets[ i ];
+		}
+
+		if ( is_redundant ) {
+			self->mCommandsElided++;
+			return;
+		}
+
+		if ( bindings.size() < firstBinding + bindingCount ) {
+			bindings.resize( firstBinding + bindingCount, {} );
+		}
+
+		for ( uint32_t i = 0; i != bindingCount; i++ ) {
+			bindings[ firstBinding + i ] = { pBuffers[ i ], pOffsets[ i ], true };
+		}
+	}
+#endif
 
 	size_t dataBuffersSize = ( sizeof( le_resource_handle_t ) ) * bindingCount;
 	size_t dataOffsetsSize = ( sizeof( uint64_t ) ) * bindingCount;
 
+	auto cmd = EMPLACE_CMD_WITH_PAYLOAD( le::CommandBindVertexBuffers, dataBuffersSize + dataOffsetsSize ); // placement new!
+
 	void *dataBuffers = ( cmd + 1 );
 	void *dataOffsets = ( static_cast<char *>( dataBuffers ) + dataBuffersSize ); // start address for offset data
 
@@ -296,6 +637,21 @@ static void cbe_bind_index_buffer( le_command_buffer_encoder_o *self,
                                    uint64_t                     offset,
                                    le::IndexType const &        indexType ) {
 
+#if ( LE_ENCODER_ELIDE_REDUNDANT_STATE )
+	{
+		auto &state = self->state;
+		if ( state.has_index_buffer &&
+		     state.index_buffer.info.buffer == buffer &&
+		     state.index_buffer.info.offset == offset &&
+		     state.index_buffer.info.indexType == indexType ) {
+			self->mCommandsElided++;
+			return;
+		}
+		state.index_buffer.info = { buffer, offset, indexType, 0 };
+		state.has_index_buffer  = true;
+	}
+#endif
+
 	auto cmd = EMPLACE_CMD( le::CommandBindIndexBuffer );
 
 	// Note: indexType==0 means uint16, indexType==1 means uint32
@@ -378,7 +734,8 @@ static void cbe_set_index_data( le_command_buffer_encoder_o *self,
 
 // ----------------------------------------------------------------------
 
-static void cbe_bind_argument_buffer( le_command_buffer_encoder_o *self, le_resource_handle_t const bufferId, uint64_t argumentName, uint64_t offset, uint64_t range ) {
+// Records bind argument buffer command - without checking whether it is redundant.
+static void cbe_record_bind_argument_buffer( le_command_buffer_encoder_o *self, le_resource_handle_t const bufferId, uint64_t argumentName, uint64_t offset, uint64_t range ) {
 
 	auto cmd = EMPLACE_CMD( le::CommandBindArgumentBuffer );
 
@@ -391,6 +748,19 @@ static void cbe_bind_argument_buffer( le_command_buffer_encoder_o *self, le_reso
 	self->mCommandCount++;
 }
 
+// ----------------------------------------------------------------------
+
+static void cbe_bind_argument_buffer( le_command_buffer_encoder_o *self, le_resource_handle_t const bufferId, uint64_t argumentName, uint64_t offset, uint64_t range ) {
+
+	uint64_t const value[ 3 ] = { bufferId.handle.as_data, offset, range };
+
+	if ( cbe_state_set_argument( self, le_encoder_argument_kind::eBuffer, argumentName, 0, value, sizeof( value ) ) ) {
+		return;
+	}
+
+	cbe_record_bind_argument_buffer( self, bufferId, argumentName, offset, range );
+}
+
 // ----------------------------------------------------------------------
 static void cbe_set_argument_data( le_command_buffer_encoder_o *self,
                                    uint64_t                     argumentNameId, // hash id of argument name
@@ -404,6 +774,11 @@ static void cbe_set_argument_data( le_command_buffer_encoder_o *self,
 
 	// --------| invariant: there are some bytes to set
 
+	if ( cbe_state_set_argument( self, le_encoder_argument_kind::eData, argumentNameId, 0, data, numBytes ) ) {
+		// Argument already holds the same data - no need to upload it again.
+		return;
+	}
+
 	void *   memAddr;
 	uint64_t bufferOffset = 0;
 
@@ -420,11 +795,12 @@ static void cbe_set_argument_data( le_command_buffer_encoder_o *self,
 
 		le_resource_handle_t allocatorBuffer = le_allocator_linear_i.get_le_resource_id( allocator );
 
-		cbe_bind_argument_buffer( self, allocatorBuffer, argumentNameId, uint32_t( bufferOffset ), uint32_t( numBytes ) );
+		cbe_record_bind_argument_buffer( self, allocatorBuffer, argumentNameId, uint32_t( bufferOffset ), uint32_t( numBytes ) );
 
 	} else {
 		std::cerr << "ERROR " << __PRETTY_FUNCTION__ << " could not allocate " << numBytes << " Bytes." << std::endl
 		          << std::flush;
+		cbe_state_forget_argument( self, argumentNameId, 0 );
 		return;
 	}
 }
@@ -433,6 +809,10 @@ static void cbe_set_argument_data( le_command_buffer_encoder_o *self,
 
 static void cbe_set_argument_texture( le_command_buffer_encoder_o *self, le_texture_handle const textureId, uint64_t argumentName, uint64_t arrayIndex ) {
 
+	if ( cbe_state_set_argument( self, le_encoder_argument_kind::eTexture, argumentName, arrayIndex, &textureId, sizeof( textureId ) ) ) {
+		return;
+	}
+
 	auto cmd = EMPLACE_CMD( le::CommandSetArgumentTexture );
 
 	cmd->info.argument_name_id = argumentName;
@@ -447,6 +827,10 @@ static void cbe_set_argument_texture( le_command_buffer_encoder_o *self, le_text
 
 static void cbe_set_argument_image( le_command_buffer_encoder_o *self, le_resource_handle_t const imageId, uint64_t argumentName, uint64_t arrayIndex ) {
 
+	if ( cbe_state_set_argument( self, le_encoder_argument_kind::eImage, argumentName, arrayIndex, &imageId.handle.as_data, sizeof( imageId.handle.as_data ) ) ) {
+		return;
+	}
+
 	auto cmd = EMPLACE_CMD( le::CommandSetArgumentImage );
 
 	cmd->info.argument_name_id = argumentName;
@@ -461,6 +845,10 @@ static void cbe_set_argument_image( le_command_buffer_encoder_o *self, le_resour
 
 static void cbe_set_argument_tlas( le_command_buffer_encoder_o *self, le_resource_handle_t const tlasId, uint64_t argumentName, uint64_t arrayIndex ) {
 
+	if ( cbe_state_set_argument( self, le_encoder_argument_kind::eTlas, argumentName, arrayIndex, &tlasId.handle.as_data, sizeof( tlasId.handle.as_data ) ) ) {
+		return;
+	}
+
 	auto cmd = EMPLACE_CMD( le::CommandSetArgumentTlas );
 
 	cmd->info.argument_name_id = argumentName;
@@ -475,6 +863,10 @@ static void cbe_set_argument_tlas( le_command_buffer_encoder_o *self, le_resourc
 
 static void cbe_bind_graphics_pipeline( le_command_buffer_encoder_o *self, le_gpso_handle gpsoHandle ) {
 
+	if ( cbe_state_bind_pipeline( self, le::CommandType::eBindGraphicsPipeline, gpsoHandle ) ) {
+		return;
+	}
+
 	// -- insert graphics PSO pointer into command stream
 	auto cmd = EMPLACE_CMD( le::CommandBindGraphicsPipeline );
 
@@ -488,6 +880,9 @@ static void cbe_bind_graphics_pipeline( le_command_buffer_encoder_o *self, le_gp
 
 static void cbe_bind_rtx_pipeline( le_command_buffer_encoder_o *self, le_shader_binding_table_o *sbt ) {
 
+	// Rtx pipeline binds are never elided, as each bind carries its own shader binding table.
+	cbe_state_bind_pipeline( self, le::CommandType::eBindRtxPipeline, nullptr );
+
 	// -- insert rtx PSO pointer into command stream
 	auto cmd = EMPLACE_CMD( le::CommandBindRtxPipeline );
 
@@ -687,6 +1082,10 @@ static void cbe_bind_rtx_pipeline( le_command_buffer_encoder_o *self, le_shader_
 
 static void cbe_bind_compute_pipeline( le_command_buffer_encoder_o *self, le_cpso_handle cpsoHandle ) {
 
+	if ( cbe_state_bind_pipeline( self, le::CommandType::eBindComputePipeline, cpsoHandle ) ) {
+		return;
+	}
+
 	// -- insert compute PSO pointer into command stream
 	auto cmd = EMPLACE_CMD( le::CommandBindComputePipeline );
 
@@ -718,7 +1117,7 @@ static void cbe_write_to_buffer( le_command_buffer_encoder_o *self, le_resource_
 		memcpy( memAddr, data, numBytes );
 
 		cmd->info.src_buffer_id = srcResourceId;
-		cmd->info.src_offset    = 0; // staging allocator will give us a fresh buffer, and src memory will be placed at its start
+		cmd->info.src_offset    = 0; // relative to staging allocation - backend resolves where allocation lives within its staging buffer
 		cmd->info.dst_offset    = offset;
 		cmd->info.numBytes      = numBytes;
 		cmd->info.dst_buffer_id = resourceId;
@@ -799,9 +1198,9 @@ static void cbe_build_rtx_blas( le_command_buffer_encoder_o *     self,
 		return;
 	}
 
-	auto   cmd       = EMPLACE_CMD( le::CommandBuildRtxBlas );
-	void * data      = cmd + 1;
 	size_t data_size = sizeof( le_resource_handle_t ) * handles_count;
+	auto   cmd       = EMPLACE_CMD_WITH_PAYLOAD( le::CommandBuildRtxBlas, data_size );
+	void * data      = cmd + 1;
 
 	cmd->info                    = {};
 	cmd->info.blas_handles_count = handles_count;
@@ -821,7 +1220,10 @@ void cbe_build_rtx_tlas( le_command_buffer_encoder_o *     self,
                          le_resource_handle_t const *      blas_handles,
                          uint32_t                          instances_count ) {
 
-	auto cmd = EMPLACE_CMD( le::CommandBuildRtxTlas );
+	// We store the blas handles inline with the command, see below.
+	size_t payload_size = sizeof( le_resource_handle_t ) * instances_count;
+
+	auto cmd = EMPLACE_CMD_WITH_PAYLOAD( le::CommandBuildRtxTlas, payload_size );
 
 	cmd->info                          = {};
 	cmd->info.tlas_handle              = *tlas_handle;
@@ -864,7 +1266,6 @@ void cbe_build_rtx_tlas( le_command_buffer_encoder_o *     self,
 	// VkAccelerationStructureHandles in the backend, where the names of the actual objects
 	// are known.
 
-	size_t payload_size = sizeof( le_resource_handle_t ) * instances_count;
 	cmd->header.info.size += payload_size;
 
 	void *memAddr = cmd + 1; // move to position just after command
@@ -881,7 +1282,7 @@ static void cbe_get_encoded_data( le_command_buffer_encoder_o *self,
                                   size_t *                     numBytes,
                                   size_t *                     numCommands ) {
 
-	*data        = self->mCommandStream;
+	*data        = self->mChunks.empty() ? nullptr : self->mChunks.front()->data;
 	*numBytes    = self->mCommandStreamSize;
 	*numCommands = self->mCommandCount;
 }
@@ -892,6 +1293,12 @@ static le_pipeline_manager_o *cbe_get_pipeline_manager( le_command_buffer_encode
 	return self->pipelineManager;
 }
 
+// ----------------------------------------------------------------------
+// Returns number of commands which were not recorded because they would not have changed state.
+static size_t cbe_get_elided_commands_count( le_command_buffer_encoder_o *self ) {
+	return self->mCommandsElided;
+}
+
 // ----------------------------------------------------------------------
 
 le_shader_binding_table_o *cbe_build_shader_binding_table( le_command_buffer_encoder_o *self, le_rtxpso_handle pipeline ) {
@@ -973,6 +1380,8 @@ void register_le_command_buffer_encoder_api( void *api_ ) {
 	cbe_i.build_rtx_tlas         = cbe_build_rtx_tlas;
 	cbe_i.get_pipeline_manager   = cbe_get_pipeline_manager;
 
+	cbe_i.get_elided_commands_count = cbe_get_elided_commands_count;
+
 	cbe_i.build_sbt         = cbe_build_shader_binding_table;
 	cbe_i.sbt_set_ray_gen   = sbt_set_ray_gen;
 	cbe_i.sbt_add_hit       = sbt_add_hit;
@@ -97,7 +97,7 @@ static le_renderer_o *renderer_create() {
 	const_cast<le_renderer_api *>( le_renderer_api_i )->le_renderer_i.le_texture_handle_store = texture_handle_library;
 
 #if ( LE_MT > 0 )
-	le_jobs::initialize( LE_MT );
+	le_jobs::initialize( LE_MT, 0 );
 #endif
 
 	return obj;
@@ -198,6 +198,13 @@ static le_shader_module_o *renderer_create_shader_module( le_renderer_o *self, c
 	return vk_backend_i.create_shader_module( self->backend, path, moduleType, macro_definitions );
 }
 
+// ----------------------------------------------------------------------
+/// \brief declare a batch of shader modules, which are compiled concurrently if LE_MT > 0
+static void renderer_create_shader_modules( le_renderer_o *self, uint32_t num_modules, char const *const *paths, LeShaderStageEnum const *moduleTypes, char const *const *macro_definitions, le_shader_module_o **modules ) {
+	using namespace le_backend_vk;
+	vk_backend_i.create_shader_modules( self->backend, num_modules, paths, moduleTypes, macro_definitions, modules );
+}
+
 // ----------------------------------------------------------------------
 
 static le_rtx_blas_info_handle renderer_create_rtx_blas_info_handle( le_renderer_o *self, le_rtx_geometry_t *geometries, uint32_t geometries_count, LeBuildAccelerationStructureFlags const *flags ) {
@@ -514,7 +521,7 @@ static void renderer_update( le_renderer_o *self, le_render_module_o *module_ )
 	le_jobs::job_t      j{ update_shader_modules_fun, self->backend };
 	le_jobs::counter_t *shader_counter;
 
-	le_jobs::run_jobs( &j, 1, &shader_counter );
+	le_jobs::run_jobs_ex( &j, 1, &shader_counter, LeJobPriority::eFrameCritical, LE_JOB_AFFINITY_ANY );
 
 #else
 	vk_backend_i.update_shader_modules( self->backend );
@@ -586,7 +593,9 @@ static void renderer_update( le_renderer_o *self, le_render_module_o *module_ )
 
 		assert( self->backend );
 
-		le_jobs::run_jobs( jobs, 3, &counter );
+		// Frame jobs are latency-critical: they must not queue behind background
+		// work, such as asset streaming, which may have been issued to the job system.
+		le_jobs::run_jobs_ex( jobs, 3, &counter, LeJobPriority::eFrameCritical, LE_JOB_AFFINITY_ANY );
 
 		// we could theoretically do some more work on the main thread here...
 
@@ -655,6 +664,7 @@ static le_resource_info_t get_default_resource_info_for_image() {
 		img.sample_count_log2 = 0; // 0 means 1, as (1 << 0 == 1)
 		img.imageType         = le::ImageType::e2D;
 		img.tiling            = le::ImageTiling::eOptimal;
+		img.is_transient      = false;
 	}
 
 	return res;
@@ -684,6 +694,7 @@ LE_MODULE_REGISTER_IMPL( le_renderer, api ) {
 	le_renderer_i.setup                  = renderer_setup;
 	le_renderer_i.update                 = renderer_update;
 	le_renderer_i.create_shader_module   = renderer_create_shader_module;
+	le_renderer_i.create_shader_modules  = renderer_create_shader_modules;
 	le_renderer_i.get_swapchain_resource = renderer_get_swapchain_resource;
 	le_renderer_i.get_swapchain_extent   = renderer_get_swapchain_extent;
 	le_renderer_i.get_pipeline_manager   = renderer_get_pipeline_manager;
@@ -30,6 +30,10 @@ struct le_renderer_api {
 		void                           ( *update                                )( le_renderer_o *obj, le_render_module_o *module );
         le_shader_module_o*            ( *create_shader_module                  )( le_renderer_o *self, char const *path, const LeShaderStageEnum& mtype, char const * macro_definitions );
 
+		/// creates `num_modules` shader modules at once - modules are compiled concurrently if LE_MT > 0.
+		/// `macro_definitions` may be nullptr. Each element of `modules` receives a module, or nullptr upon failure.
+		void                           ( *create_shader_modules                 )( le_renderer_o *self, uint32_t num_modules, char const * const * paths, LeShaderStageEnum const * mtypes, char const * const * macro_definitions, le_shader_module_o** modules );
+
 		/// returns the resource handle for the current swapchain image
 		le_resource_handle_t           ( *get_swapchain_resource                )( le_renderer_o* self );
 		void                           ( *get_swapchain_extent                  )( le_renderer_o* self, uint32_t* p_width, uint32_t* p_height);
@@ -172,7 +176,10 @@ struct le_renderer_api {
         void                         ( *trace_rays             )( le_command_buffer_encoder_o* self, uint32_t width, uint32_t height, uint32_t depth);
 
 		le_pipeline_manager_o*       ( *get_pipeline_manager   )( le_command_buffer_encoder_o *self );
+		// Note: encoded data may be spread over several chunks, which are linked via le::CommandJump commands.
 		void                         ( *get_encoded_data       )( le_command_buffer_encoder_o *self, void **data, size_t *numBytes, size_t *numCommands );
+		// Number of binds and state sets which were dropped because they would not have changed state.
+		size_t                       ( *get_elided_commands_count )( le_command_buffer_encoder_o *self );
 	};
 
 	renderer_interface_t               le_renderer_i;
@@ -497,6 +504,13 @@ class ImageInfoBuilder : NoCopy, NoMove {
 		return *this;
 	}
 
+	// Transient images promise not to read contents written in an earlier frame -
+	// this allows the backend to let them share memory with other transient images.
+	ImageInfoBuilder &setIsTransient( bool isTransient = true ) {
+		img.is_transient = isTransient;
+		return *this;
+	}
+
 	const le_resource_info_t &build() {
 		return res;
 	}
@@ -17,6 +17,14 @@
 
 #include "3rdparty/src/spooky/SpookyV2.h" // for calculating rendergraph hash
 
+#ifndef LE_MT
+#	define LE_MT 0
+#endif
+
+#if ( LE_MT > 0 )
+#	include "le_jobs/le_jobs.h"
+#endif
+
 #ifndef PRINT_DEBUG_MESSAGES
 #	define PRINT_DEBUG_MESSAGES false
 #endif
@@ -29,16 +37,64 @@
 #	endif
 #endif
 
-#include <bitset>
 #include <set>
 
-constexpr size_t MAX_NUM_LAYER_RESOURCES   = 4096; // set this to larger value if you want to deal with a larger number of distinct resources.
-using BitField                             = std::bitset<MAX_NUM_LAYER_RESOURCES>;
-static auto LE_RENDER_GRAPH_ROOT_LAYER_TAG = LE_RESOURCE( "LE_RENDER_GRAPH_ROOT_LAYER_TAG", LeResourceType::eUndefined );
+// Maps resource handles to unique resource indices - indices are monotonic
+// and non-sparse, in order of first use within a rendergraph.
+using ResourceIndexMap = std::unordered_map<le_resource_handle_t, uint32_t, LeResourceHandleIdentity>;
 
+// A task lists unique resource indices for all resources which a pass reads
+// from, and writes to. Most passes only touch a handful of resources, which is
+// why we store indices rather than a bitfield over all resources in the graph.
 struct Task {
-	BitField reads;
-	BitField writes;
+	std::vector<uint32_t> reads;
+	std::vector<uint32_t> writes;
+	bool                  isContributing = false; // root tasks, and tasks which contribute to a root task
+};
+
+// Set of unique resource indices, used to accumulate reads or writes over tasks.
+//
+// Membership is tested via a bitfield with one bit per unique resource in the
+// rendergraph. We keep a list of members so that clearing only needs to touch
+// words which have bits set - cost of any operation is proportional to the number
+// of resources involved, not to the number of resources in the rendergraph.
+class ResourceSet {
+	std::vector<uint64_t> bits;
+	std::vector<uint32_t> members;
+
+  public:
+	explicit ResourceSet( size_t num_resources )
+	    : bits( ( num_resources + 63 ) / 64, 0 ) {
+	}
+
+	bool contains( uint32_t index ) const {
+		return bits[ index >> 6 ] & ( uint64_t( 1 ) << ( index & 63 ) );
+	}
+
+	void insert( std::vector<uint32_t> const &indices ) {
+		for ( auto const &i : indices ) {
+			if ( !contains( i ) ) {
+				bits[ i >> 6 ] |= ( uint64_t( 1 ) << ( i & 63 ) );
+				members.push_back( i );
+			}
+		}
+	}
+
+	bool intersects( std::vector<uint32_t> const &indices ) const {
+		for ( auto const &i : indices ) {
+			if ( contains( i ) ) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void clear() {
+		for ( auto const &i : members ) {
+			bits[ i >> 6 ] = 0;
+		}
+		members.clear();
+	}
 };
 
 // these are some sanity checks for le_renderer_types
@@ -91,6 +147,8 @@ struct le_render_module_o : NoCopy, NoMove {
 struct le_rendergraph_o : NoCopy, NoMove {
 	std::vector<le_renderpass_o *>    passes;
 	std::vector<uint32_t>             sortIndices;
+	uint64_t                          build_hash = 0;          // structural hash over passes at last build, see rendergraph_calculate_structure_hash
+	std::vector<uint32_t>             build_sort_indices;      // sort indices (before consolidation) calculated at last build - valid for build_hash
 	std::vector<le_resource_handle_t> declared_resources_id;   // | pre-declared resources (declared via module)
 	std::vector<le_resource_info_t>   declared_resources_info; // | pre-declared resources (declared via module)
 };
@@ -471,13 +529,13 @@ static void rendergraph_add_renderpass( le_rendergraph_o *self, le_renderpass_o
 /// \brief Tag any tasks which contribute to any root task
 /// \details We do this so that we can weed out any tasks which are provably
 ///          not contributing - these don't need to be executed at all.
-static void tasks_tag_contributing( Task *const tasks, const size_t numTasks ) {
+static void tasks_tag_contributing( Task *const tasks, const size_t numTasks, const size_t numUniqueResources ) {
 
 	// we must iterate backwards from last layer to first layer
 	Task *            task      = tasks + numTasks;
 	Task const *const task_rend = tasks;
 
-	BitField read_accum;
+	ResourceSet read_accum( numUniqueResources );
 
 	// find first root layer
 	//    monitored reads will be from the first root layer
@@ -485,19 +543,19 @@ static void tasks_tag_contributing( Task *const tasks, const size_t numTasks ) {
 	while ( task != task_rend ) {
 		--task;
 
-		bool isRoot = task->reads[ 0 ]; // any task which has the root signal set in the first read channel is considered a root task
+		bool isRoot = task->isContributing; // on entry, only root tasks are marked as contributing
 
 		// If it's a root task, get all reads from (= providers to) this task
 		// If it's not a root task, first see if there are any writes to currently monitored reads
 		//    if yes, add all reads to monitored reads
 
-		if ( isRoot || ( task->writes & read_accum ).any() ) {
+		if ( isRoot || read_accum.intersects( task->writes ) ) {
 			// If this task is a root task - OR					      ) this means the layer is contributing
 			// If this task writes to any subsequent monitored reads, )
 			// Then we must monitor all reads by this task.
-			read_accum |= task->reads;
+			read_accum.insert( task->reads );
 
-			task->reads[ 0 ] = true; // Make sure the task is tagged as contributing
+			task->isContributing = true; // Make sure the task is tagged as contributing
 		} else {
 			// Otherwise - this task does not contribute
 		}
@@ -505,14 +563,10 @@ static void tasks_tag_contributing( Task *const tasks, const size_t numTasks ) {
 }
 
 /// Note: `sortIndices` must point to an array of `numtasks` elements of type uint32_t
-static void tasks_calculate_sort_indices( Task const *const tasks, const size_t numTasks, uint32_t *sortIndices ) {
+static void tasks_calculate_sort_indices( Task const *const tasks, const size_t numTasks, const size_t numUniqueResources, uint32_t *sortIndices ) {
 
-	BitField read_accum{};
-	BitField write_accum{};
-
-	/// Each bit in the task bitfield stands for one resource.
-	/// Bitfield index corresponds to a resource id. Note that
-	/// bitfields are indexed right-to left (index zero is right-most).
+	ResourceSet read_accum( numUniqueResources );
+	ResourceSet write_accum( numUniqueResources );
 
 	bool needs_barrier = false;
 
@@ -525,32 +579,31 @@ static void tasks_calculate_sort_indices( Task const *const tasks, const size_t
 
 			// Weed out any tasks which are marked as non-contributing
 
-			if ( task->reads[ 0 ] == false ) {
+			if ( task->isContributing == false ) {
 				*taskOrder = ~( 0u ); // tag task as not contributing by marking it with the maximum sort index
 				continue;
 			}
 
-			BitField read_write = ( task->reads & task->writes ); // read_after write in same task - this means a task boundary if it does touch any previously read or written elements
-
 			// A barrier is needed, if:
-			needs_barrier = ( read_accum & read_write ).any() ||    // - any previously read elements are touched by read-write, OR
-			                ( write_accum & read_write ).any() ||   // - any previously written elements are touched by read-write, OR
-			                ( write_accum & task->reads ).any() ||  // - the current task wants to read from a previously written task, OR
-			                ( write_accum & task->writes ).any() || // - the current task writes to a previously written resource, OR
-			                ( read_accum & task->writes ).any();    // - the current task wants to write to a task which was previously read.
+			needs_barrier = write_accum.intersects( task->reads ) ||  // - the current task wants to read from a previously written task, OR
+			                write_accum.intersects( task->writes ) || // - the current task writes to a previously written resource, OR
+			                read_accum.intersects( task->writes );    // - the current task wants to write to a task which was previously read.
+
+			// Note that this includes the case where the current task reads from and writes to the same
+			// resource, and any previous task has either read from or written to this resource.
 
 			//			std::cout << "Needs barrier: " << ( needs_barrier ? "true" : "false" ) << std::endl
 			//			          << std::flush;
 
 			if ( needs_barrier ) {
 				++sortIndex;         // Barriers are expressed by increasing the sortIndex. tasks with the same sortIndex *may* execute concurrently.
-				read_accum.reset();  // Barriers apply everything before the current task
-				write_accum.reset(); //
+				read_accum.clear();  // Barriers apply everything before the current task
+				write_accum.clear(); //
 				needs_barrier = false;
 			}
 
-			write_accum |= task->writes;
-			read_accum |= task->reads;
+			write_accum.insert( task->writes );
+			read_accum.insert( task->reads );
 
 			*taskOrder = sortIndex; // store current sortIndex value with task
 
@@ -580,11 +633,14 @@ std::filesystem::path getexepath() {
 //
 static bool
 generate_dot_file_for_rendergraph(
-    le_rendergraph_o *    self,
-    le_resource_handle_t *uniqueResources,
-    size_t const &        numUniqueResources,
-    Task const *          tasks,
-    size_t                frame_number ) {
+    le_rendergraph_o *      self,
+    ResourceIndexMap const &resourceIndices,
+    Task const *            tasks,
+    size_t                  frame_number ) {
+
+	auto task_contains = []( std::vector<uint32_t> const &indices, uint32_t res_idx ) -> bool {
+		return std::find( indices.begin(), indices.end(), res_idx ) != indices.end();
+	};
 
 	std::filesystem::path exe_path = getexepath();
 
@@ -624,19 +680,11 @@ generate_dot_file_for_rendergraph(
 			os << r.debug_name << "\">";
 
 			{
-				auto const needle = r;
-
-				size_t res_idx = 0; // unique resource id (monotonic, non-sparse, index into bitfield)
-				for ( auto ur = uniqueResources; res_idx != numUniqueResources; res_idx++, ur++ ) {
-					if ( *ur == needle ) {
-						// found matching resource, res_idx is index into uniqueHandles for resource
-						break;
-					}
-				}
+				uint32_t res_idx = resourceIndices.at( r ); // unique resource id
 
 				// if resource is being written to, then underline resource name
 
-				if ( tasks[ i ].writes[ res_idx ] ) {
+				if ( task_contains( tasks[ i ].writes, res_idx ) ) {
 					os << "<u>" << r.debug_name << "</u>";
 				} else {
 					os << "" << r.debug_name << "";
@@ -692,27 +740,20 @@ generate_dot_file_for_rendergraph(
 
 			auto const needle = p->resources[ j ];
 
-			size_t res_idx = 0; // unique resource id (monotonic, non-sparse, index into bitfield)
-			for ( auto r = uniqueResources; res_idx != numUniqueResources; res_idx++, r++ ) {
-				if ( *r == needle ) {
-					// found matching resource, res_idx is index into uniqueHandles for resource
-					break;
-				}
-			}
+			auto res_it = resourceIndices.find( needle );
+
+			assert( res_it != resourceIndices.end() && "something went wrong, handle could not be found in list of unique handles." );
 
-			assert( res_idx != numUniqueResources && "something went wrong, handle could not be found in list of unique handles." );
+			uint32_t res_idx = res_it->second; // unique resource id
 
-			if ( !tasks[ i ].writes[ res_idx ] ) {
+			if ( !task_contains( tasks[ i ].writes, res_idx ) ) {
 				continue;
 			}
 
 			// now we must find any subsequent tasks which read from this resource.
 
-			BitField res_filter = 1 << res_idx;
-
 			for ( size_t k = i + 1; k != self->passes.size(); k++ ) {
-				if ( ( tasks[ k ].reads & res_filter ).any() ||
-				     ( tasks[ k ].writes & tasks[ k ].reads & res_filter ).any() ) {
+				if ( task_contains( tasks[ k ].reads, res_idx ) ) {
 
 					os << "\"" << p->debugName << "\":"
 					   << "\"" << needle.debug_name << "\""
@@ -723,7 +764,7 @@ generate_dot_file_for_rendergraph(
 					   << ( self->sortIndices[ k ] == ( ~0u ) ? "[style=dashed]" : "" )
 					   << ";" << std::endl;
 				}
-				if ( ( tasks[ k ].writes & res_filter ).any() ) {
+				if ( task_contains( tasks[ k ].writes, res_idx ) ) {
 					break;
 				}
 			}
@@ -763,29 +804,46 @@ generate_dot_file_for_rendergraph(
 };
 
 // ----------------------------------------------------------------------
-// Calculate a topological order for passes within rendergraph.
-//
-// We assume that passes arrive in partial-order (i.e. the order
-// of adding passes to a module is meaningful)
+// Hash over everything which influences sort indices: pass ids, root flags,
+// and - for each pass - resources used, and how they are accessed.
 //
-// As a side-effect, this method:
-// + Removes (and deletes) any passes which do not contribute from a rendergraph.
-// + Updates sortIndices so that it has same number of elements as rendergraph.
-// After completion this method guarantees that sortIndices constains a valid
-// sort index for each corresponding renderpass.
-//
-static void rendergraph_build( le_rendergraph_o *self, size_t frame_number ) {
+// If two rendergraphs have the same structure hash, they will have
+// identical sort indices.
+static uint64_t rendergraph_calculate_structure_hash( le_rendergraph_o const *self ) {
+
+	SpookyHash hash;
+	hash.Init( 0, 0 );
+
+	for ( auto const &p : self->passes ) {
+		uint64_t const pass_info[ 3 ] = { p->id, p->isRoot, p->resources.size() };
+		hash.Update( pass_info, sizeof( pass_info ) );
+		for ( auto const &r : p->resources ) {
+			hash.Update( &r.handle.as_data, sizeof( uint64_t ) );
+		}
+		hash.Update( p->resources_access_flags.data(), sizeof( LeAccessFlags ) * p->resources_access_flags.size() );
+	}
+
+	uint64_t hash_1, hash_2;
+	hash.Final( &hash_1, &hash_2 );
+
+	return hash_1;
+}
+
+// ----------------------------------------------------------------------
+// Calculate sort indices for all passes in rendergraph, and store them
+// in self->sortIndices. Passes which don't contribute to any root pass
+// receive a sort index of (unsigned) -1.
+static void rendergraph_calculate_sort_indices( le_rendergraph_o *self, size_t frame_number ) {
 
 	// We must express our list of passes as a list of tasks.
-	// A task holds two bitfields, the bitfield names are: `read` and `write`.
-	// Each bit in the bitfield represents a possible resource.
-	// This means we must create a list of unique resources, so that we can use the resource index as the
-	// offset value for a bit representing this particular resource in the bitfields.
+	// A task holds two lists of resources, named: `reads` and `writes`.
+	// Resources are identified by their unique resource index, which we assign
+	// in order of first use, so that indices are non-sparse, and may be used
+	// as offsets into bitfields over all resources used in the rendergraph.
 
-	std::vector<Task>                                         tasks;
-	std::array<le_resource_handle_t, MAX_NUM_LAYER_RESOURCES> uniqueHandles; // lookup for resource handles.
-	uniqueHandles[ 0 ]        = LE_RENDER_GRAPH_ROOT_LAYER_TAG;              // handle with index zero is marker for root tasks
-	size_t numUniqueResources = 1;
+	std::vector<Task> tasks;
+	ResourceIndexMap  resourceIndices; // lookup for unique resource index by resource handle
+	tasks.reserve( self->passes.size() );
 
 	// Translate all passes into a task
 	//   Get list of resources per pass and build task from this
@@ -800,53 +858,35 @@ static void rendergraph_build( le_rendergraph_o *self, size_t frame_number ) {
 			auto const &         resource_handle = p->resources[ i ];
 			LeAccessFlags const &access_flags    = p->resources_access_flags[ i ];
 
-			size_t res_idx = 0; // unique resource id (monotonic, non-sparse, index into bitfield)
-			for ( auto r = uniqueHandles.data(); res_idx != numUniqueResources; res_idx++, r++ ) {
-				if ( *r == resource_handle ) {
-					// found matching resource, res_idx is index into uniqueHandles for resource
-					break;
-				}
-			}
+			// Find unique resource id - if resource was not found, it gets added with the next free index.
+			uint32_t res_idx = resourceIndices.emplace( resource_handle, uint32_t( resourceIndices.size() ) ).first->second;
 
-			if ( res_idx == numUniqueResources ) {
-				// resource was not found, we must add a new resource
-				uniqueHandles[ res_idx ] = resource_handle;
-				numUniqueResources++;
+			if ( access_flags & LeAccessFlagBits::eLeAccessFlagBitRead ) {
+				task.reads.push_back( res_idx );
+			}
+			if ( access_flags & LeAccessFlagBits::eLeAccessFlagBitWrite ) {
+				task.writes.push_back( res_idx );
 			}
-
-			// --------| invariant: uniqueHandles[res_idx] is valid
-
-			task.reads |= ( ( access_flags & LeAccessFlagBits::eLeAccessFlagBitRead ) << res_idx );
-			task.writes |= ( ( ( access_flags & LeAccessFlagBits::eLeAccessFlagBitWrite ) >> 1 ) << res_idx );
 		}
 
-		if ( p->isRoot ) {
-			// Any task which has reads[0] set to true is marked as a root task.
-			task.reads[ 0 ] = true;
-		}
+		// Root tasks are contributing by definition.
+		task.isContributing = p->isRoot;
 
 		tasks.emplace_back( std::move( task ) );
 	}
 
+	const size_t numUniqueResources = resourceIndices.size();
+
 	// Tag all tasks which contribute to any root task.
 	//
 	// Tasks which don't contribute to any root task
 	// can be disposed, as their products will never be used.
-	tasks_tag_contributing( tasks.data(), tasks.size() );
+	tasks_tag_contributing( tasks.data(), tasks.size(), numUniqueResources );
 
 	self->sortIndices.resize( tasks.size(), 0 );
 
 	// Associate sort indices to tasks
-	tasks_calculate_sort_indices( tasks.data(), tasks.size(), self->sortIndices.data() );
-
-	auto printPassList = [ & ]() -> void {
-		for ( size_t i = 0; i != self->sortIndices.size(); ++i ) {
-			std::cout << "Pass: " << std::dec << std::setw( 3 ) << i << " sort order : " << std::setw( 12 ) << self->sortIndices[ i ] << " : "
-			          << self->passes[ i ]->debugName
-			          << std::endl
-			          << std::flush;
-		}
-	};
+	tasks_calculate_sort_indices( tasks.data(), tasks.size(), numUniqueResources, self->sortIndices.data() );
 
 #if ( DEBUG_GENERATE_DOT_GRAPH )
 	{
@@ -859,27 +899,68 @@ static void rendergraph_build( le_rendergraph_o *self, size_t frame_number ) {
 
 		// calculate hash over all tasks, their signatures
 
-		std::hash<BitField> bit_hash;
-
-		std::vector<size_t> task_hashes;
+		std::vector<uint64_t> task_hashes;
 		task_hashes.reserve( tasks.size() * 2 );
 
 		for ( auto &t : tasks ) {
-			task_hashes.emplace_back( bit_hash( t.reads ) );
-			task_hashes.emplace_back( bit_hash( t.writes ) );
+			task_hashes.emplace_back( SpookyHash::Hash64( t.reads.data(), sizeof( uint32_t ) * t.reads.size(), 0 ) );
+			task_hashes.emplace_back( SpookyHash::Hash64( t.writes.data(), sizeof( uint32_t ) * t.writes.size(), t.isContributing ) );
 		}
 
-		uint64_t tasks_hash = SpookyHash::Hash64( task_hashes.data(), sizeof( size_t ) * task_hashes.size(), 0 );
-		SpookyHash::Hash64( uniqueHandles.data(), sizeof( le_resource_handle_t ) * numUniqueResources, tasks_hash );
+		uint64_t tasks_hash = SpookyHash::Hash64( task_hashes.data(), sizeof( uint64_t ) * task_hashes.size(), 0 );
+
+		for ( auto const &r : resourceIndices ) {
+			tasks_hash ^= SpookyHash::Hash64( &r.first.handle.as_data, sizeof( uint64_t ), r.second );
+		}
 
 		static uint64_t previous_hash = 0;
 
 		if ( previous_hash != tasks_hash ) {
-			generate_dot_file_for_rendergraph( self, uniqueHandles.data(), numUniqueResources, tasks.data(), frame_number );
+			generate_dot_file_for_rendergraph( self, resourceIndices, tasks.data(), frame_number );
 			previous_hash = tasks_hash;
 		}
 	}
 #endif
+}
+
+// ----------------------------------------------------------------------
+// Calculate a topological order for passes within rendergraph.
+//
+// We assume that passes arrive in partial-order (i.e. the order
+// of adding passes to a module is meaningful)
+//
+// Since rendergraphs tend to be identical from frame to frame, we keep
+// the sort indices of the previous build, and re-use them for as long as
+// the structure hash of the rendergraph does not change.
+//
+// As a side-effect, this method:
+// + Removes (and deletes) any passes which do not contribute from a rendergraph.
+// + Updates sortIndices so that it has same number of elements as rendergraph.
+// After completion this method guarantees that sortIndices constains a valid
+// sort index for each corresponding renderpass.
+//
+static void rendergraph_build( le_rendergraph_o *self, size_t frame_number ) {
+
+	uint64_t structure_hash = rendergraph_calculate_structure_hash( self );
+
+	if ( structure_hash == self->build_hash &&
+	     self->build_sort_indices.size() == self->passes.size() ) {
+		// Rendergraph has same structure as at last build - we may re-use sort indices.
+		self->sortIndices.assign( self->build_sort_indices.begin(), self->build_sort_indices.end() );
+	} else {
+		rendergraph_calculate_sort_indices( self, frame_number );
+		self->build_hash = structure_hash;
+		self->build_sort_indices.assign( self->sortIndices.begin(), self->sortIndices.end() );
+	}
+
+	auto printPassList = [ & ]() -> void {
+		for ( size_t i = 0; i != self->sortIndices.size(); ++i ) {
+			std::cout << "Pass: " << std::dec << std::setw( 3 ) << i << " sort order : " << std::setw( 12 ) << self->sortIndices[ i ] << " : "
+			          << self->passes[ i ]->debugName
+			          << std::endl
+			          << std::flush;
+		}
+	};
 
 #if ( PRINT_DEBUG_MESSAGES )
 	printPassList();
@@ -889,22 +970,17 @@ static void rendergraph_build( le_rendergraph_o *self, size_t frame_number ) {
 		// Remove any passes from rendergraph which do not contribute.
 		// Passes which don't contribute have a sort index of (unsigned) -1.
 		//
-		// We consolidate the list of passes by rebuilding it while only
-		// including passes which contribute (whose sort index != -1)
+		// We consolidate the list of passes in-place, only keeping
+		// passes which contribute (whose sort index != -1)
 
-		size_t numSortIndices = self->sortIndices.size();
-
-		std::vector<le_renderpass_o *> consolidated_passes;
-		std::vector<uint32_t>          consolidated_sort_indices;
-
-		consolidated_passes.reserve( numSortIndices );
-		consolidated_sort_indices.reserve( numSortIndices );
+		size_t num_consolidated = 0;
 
 		for ( size_t i = 0; i != self->sortIndices.size(); i++ ) {
 			if ( self->sortIndices[ i ] != ( ~0u ) ) {
 				// valid sort index, add to consolidated passes
-				consolidated_passes.push_back( self->passes[ i ] );
-				consolidated_sort_indices.push_back( self->sortIndices[ i ] );
+				self->passes[ num_consolidated ]      = self->passes[ i ];
+				self->sortIndices[ num_consolidated ] = self->sortIndices[ i ];
+				num_consolidated++;
 			} else {
 				// Sort index hints that this pass is not used,
 				// since the rendergraph owns the pass at this point,
@@ -914,8 +990,8 @@ static void rendergraph_build( le_rendergraph_o *self, size_t frame_number ) {
 			}
 		}
 
-		std::swap( self->passes, consolidated_passes );
-		std::swap( self->sortIndices, consolidated_sort_indices );
+		self->passes.resize( num_consolidated );
+		self->sortIndices.resize( num_consolidated );
 
 #if ( PRINT_DEBUG_MESSAGES )
 		std::cout << "* Consolidated Pass List *" << std::endl
@@ -934,7 +1010,11 @@ static void rendergraph_build( le_rendergraph_o *self, size_t frame_number ) {
 ///
 /// The command stream is stored inside of the Encoder that is used to record it (that's not elegant).
 ///
-/// We could possibly go wide when recording renderpasses, with one context per renderpass.
+/// With LE_MT > 0, renderpasses are recorded in parallel, as jobs, with one encoder per
+/// renderpass - execute callbacks must therefore be safe to call concurrently with
+/// execute callbacks of other renderpasses. Each encoder draws from the transient allocator
+/// of the worker thread it runs on. Since each pass records into its own encoder, the
+/// resulting command streams don't depend on the order in which passes were recorded.
 static void rendergraph_execute( le_rendergraph_o *self, size_t frameIndex, le_backend_o *backend ) {
 
 	if ( PRINT_DEBUG_MESSAGES ) {
@@ -983,6 +1063,9 @@ static void rendergraph_execute( le_rendergraph_o *self, size_t frameIndex, le_b
 
 	const size_t numPasses = self->passes.size();
 
+	std::vector<le_renderpass_o *> recording_passes; // passes which contribute, and have execute callbacks
+	recording_passes.reserve( numPasses );
+
 	for ( size_t i = 0; i != numPasses; ++i ) {
 
 		auto &pass       = self->passes[ i ];
@@ -1021,10 +1104,29 @@ static void rendergraph_execute( le_rendergraph_o *self, size_t frameIndex, le_b
 				encoder_i.set_viewport( pass->encoder, 0, 1, default_viewport );
 			}
 
-			renderpass_run_execute_callbacks( pass ); // record draw commands into encoder
+			recording_passes.push_back( pass );
 		}
 	}
 
+	// Record draw commands into encoders.
+
+#if ( LE_MT > 0 )
+	// We're running inside a job: each pass gets recorded as a job of its own.
+	// parallel_for only returns once all passes have been recorded.
+	le_jobs::parallel_for(
+	    0, uint32_t( recording_passes.size() ), 1, []( uint32_t begin, uint32_t end, void *user_data ) {
+		    auto passes = static_cast<le_renderpass_o **>( user_data );
+		    for ( uint32_t i = begin; i != end; ++i ) {
+			    renderpass_run_execute_callbacks( passes[ i ] );
+		    }
+	    },
+	    recording_passes.data() );
+#else
+	for ( auto &pass : recording_passes ) {
+		renderpass_run_execute_callbacks( pass );
+	}
+#endif
+
 	// TODO: consolidate pipeline caches
 }
 
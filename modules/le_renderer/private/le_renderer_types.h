@@ -1405,6 +1405,7 @@ struct le_resource_info_t {
 		le::ImageTiling    tiling;            // enum VkImageTiling
 		LeImageUsageFlags  usage;             // usage flags (LeImageUsageFlags : uint32_t)
 		uint32_t           samplesFlags;      // bitfield over all variants of this image resource
+		bool               is_transient;      // contents need not outlive the frame: image may share memory with other transient images
 	};
 
 	struct BufferInfo {
@@ -1547,6 +1548,7 @@ enum class CommandType : uint32_t {
 	eBindRtxPipeline,
 	eWriteToBuffer,
 	eWriteToImage,
+	eJump, // internal: command stream continues at another address, see CommandJump
 };
 
 struct CommandHeader {
@@ -1559,6 +1561,18 @@ struct CommandHeader {
 	} info;
 };
 
+// Command streams are stored in chunks which are not contiguous in memory. Whenever
+// a command does not fit into the current chunk, the encoder places a jump command
+// at the end of the current chunk, and continues in a new chunk. Consumers of command
+// streams must continue reading at `info.next`. Jump commands don't count towards the
+// number of commands, or bytes, reported for a command stream.
+struct CommandJump {
+	CommandHeader header = { { { CommandType::eJump, sizeof( CommandJump ) } } };
+	struct {
+		void *next; // address of next command in stream
+	} info;
+};
+
 struct CommandDrawIndexed {
 	CommandHeader header = { { { CommandType::eDrawIndexed, sizeof( CommandDrawIndexed ) } } };
 	struct {
@@ -22,19 +22,34 @@
 
 #include "le_renderer/le_renderer.h" // for shader type
 
+#include "3rdparty/src/spooky/SpookyV2.h" // for calculating spir-v cache keys
+
 #include <iomanip>
 #include <iostream>
 #include <assert.h>
 
 #include <filesystem> // for parsing shader source file paths
 #include <fstream>    // for reading shader source files
+#include <sstream>
 #include <cstring>    // for memcpy
 #include <vector>
 #include <set>
+#include <dlfcn.h> // for dladdr
+#include <unistd.h> // for getpid
+#include <thread>   // for this_thread::get_id
+
+// Compiler options which affect generated code - these apply to all compilations,
+// and go into spir-v cache keys.
+static constexpr shaderc_optimization_level LE_SHADER_OPTIMIZATION_LEVEL  = shaderc_optimization_level_performance;
+static constexpr bool                       LE_SHADER_GENERATE_DEBUG_INFO = true;
+static constexpr shaderc_target_env         LE_SHADER_TARGET_ENV          = shaderc_target_env_vulkan;
+static constexpr shaderc_env_version        LE_SHADER_TARGET_ENV_VERSION  = shaderc_env_version_vulkan_1_0;
 
 struct le_shader_compiler_o {
 	shaderc_compiler_t        compiler;
 	shaderc_compile_options_t options;
+	uint64_t                  spirvCacheCompilerKey; // identifies compiler, and compiler options - see spirv_cache_calculate_compiler_key
+	std::filesystem::path     spirvCacheDirectory;   // directory for cached spir-v code, empty if cache is not available
 };
 
 // ---------------------------------------------------------------
@@ -56,6 +71,7 @@ struct IncludesList {
 
 struct le_shader_compilation_result_o {
 	shaderc_compilation_result *result = nullptr;
+	std::vector<char>           cachedSpirv; // spir-v code loaded from cache, used if result is nullptr
 	IncludesList                includes;
 };
 
@@ -156,7 +172,12 @@ static void le_shader_compilation_result_detroy( le_shader_compilation_result_o
 
 static void le_shader_compilation_result_get_result_bytes( le_shader_compilation_result_o *res, const char **pAddr, size_t *pNumBytes ) {
 
-	assert( res->result );
+	if ( res->result == nullptr ) {
+		// result was loaded from spir-v cache
+		*pAddr     = res->cachedSpirv.data();
+		*pNumBytes = res->cachedSpirv.size();
+		return;
+	}
 
 	*pAddr     = shaderc_result_get_bytes( res->result );
 	*pNumBytes = shaderc_result_get_length( res->result );
@@ -165,10 +186,47 @@ static void le_shader_compilation_result_get_result_bytes( le_shader_compilation
 // ---------------------------------------------------------------
 /// \brief returns true if compilation was a success, false otherwise
 static bool le_shader_compilation_result_get_result_success( le_shader_compilation_result_o *res ) {
-	assert( res->result );
+	if ( res->result == nullptr ) {
+		// only successful compilations are stored in spir-v cache
+		return !res->cachedSpirv.empty();
+	}
 	return shaderc_result_get_compilation_status( res->result ) == shaderc_compilation_status_success;
 }
 
+// ---------------------------------------------------------------
+// Returns a hash over everything which affects generated code apart from shader source and
+// shader kind: compiler options, and the identity of the shaderc library which we use -
+// its path, size, and modification time - so that installing a different compiler
+// (e.g. with a new Vulkan SDK) leads to new spir-v cache keys.
+static uint64_t spirv_cache_calculate_compiler_key() {
+
+	unsigned int spv_version  = 0;
+	unsigned int spv_revision = 0;
+	shaderc_get_spv_version( &spv_version, &spv_revision );
+
+	std::ostringstream identity;
+
+	identity << "spv:" << spv_version << "." << spv_revision
+	         << " opt:" << int( LE_SHADER_OPTIMIZATION_LEVEL )
+	         << " debug:" << LE_SHADER_GENERATE_DEBUG_INFO
+	         << " env:" << int( LE_SHADER_TARGET_ENV ) << "." << uint32_t( LE_SHADER_TARGET_ENV_VERSION );
+
+	Dl_info info{};
+
+	if ( dladdr( reinterpret_cast<void *>( &shaderc_compile_into_spv ), &info ) && info.dli_fname ) {
+		std::error_code ec;
+		auto            library_path = std::filesystem::canonical( info.dli_fname, ec );
+		if ( !ec ) {
+			identity << " lib:" << library_path.string()
+			         << " size:" << std::filesystem::file_size( library_path, ec )
+			         << " mtime:" << std::filesystem::last_write_time( library_path, ec ).time_since_epoch().count();
+		}
+	}
+
+	auto const identity_str = identity.str();
+	return SpookyHash::Hash64( identity_str.data(), identity_str.size(), 0 );
+}
+
 // ---------------------------------------------------------------
 
 static le_shader_compiler_o *le_shader_compiler_create() {
@@ -177,9 +235,23 @@ static le_shader_compiler_o *le_shader_compiler_create() {
 
 	{
 		obj->options = shaderc_compile_options_initialize();
-		shaderc_compile_options_set_generate_debug_info( obj->options );
+		if ( LE_SHADER_GENERATE_DEBUG_INFO ) {
+			shaderc_compile_options_set_generate_debug_info( obj->options );
+		}
 		shaderc_compile_options_set_source_language( obj->options, shaderc_source_language::shaderc_source_language_glsl );
-		shaderc_compile_options_set_optimization_level( obj->options, shaderc_optimization_level_performance );
+		shaderc_compile_options_set_optimization_level( obj->options, LE_SHADER_OPTIMIZATION_LEVEL );
+		shaderc_compile_options_set_target_env( obj->options, LE_SHADER_TARGET_ENV, LE_SHADER_TARGET_ENV_VERSION );
+	}
+
+	obj->spirvCacheCompilerKey = spirv_cache_calculate_compiler_key();
+
+	{
+		// Spir-v cache lives in a `shader_cache` directory next to the executable.
+		std::error_code ec;
+		auto            exe_path = std::filesystem::read_symlink( "/proc/self/exe", ec );
+		if ( !ec ) {
+			obj->spirvCacheDirectory = exe_path.parent_path() / "shader_cache";
+		}
 	}
 
 	return obj;
@@ -237,6 +309,104 @@ static std::vector<char> load_file( const std::filesystem::path &file_path, bool
 	return contents;
 }
 
+// ---------------------------------------------------------------
+// Spir-v cache is content-addressed: the key for a cache entry is a hash over the
+// preprocessed shader source - which contains the contents of all resolved includes, and
+// has all macro definitions applied - together with shader kind, and compiler identity and options.
+//
+// Any change to a shader source file, or to any of its includes therefore leads to a
+// new cache key, which is why cache entries never need to be explicitly invalidated.
+static uint64_t spirv_cache_calculate_key( le_shader_compiler_o const *self, shaderc_shader_kind shaderKind, char const *preprocessedText, size_t preprocessedTextNumBytes ) {
+
+	uint64_t const key_info[ 2 ] = { self->spirvCacheCompilerKey, uint64_t( shaderKind ) };
+
+	uint64_t key = SpookyHash::Hash64( key_info, sizeof( key_info ), 0 );
+	return SpookyHash::Hash64( preprocessedText, preprocessedTextNumBytes, key );
+}
+
+// ---------------------------------------------------------------
+
+static std::filesystem::path spirv_cache_get_entry_path( le_shader_compiler_o const *self, uint64_t key ) {
+	std::ostringstream filename;
+	filename << std::hex << std::setw( 16 ) << std::setfill( '0' ) << key << ".spv";
+	return self->spirvCacheDirectory / filename.str();
+}
+
+// ---------------------------------------------------------------
+// Returns true and stores spir-v code into `spirv` if a valid cache entry was found for `key`
+static bool spirv_cache_load( le_shader_compiler_o const *self, uint64_t key, std::vector<char> *spirv ) {
+
+	if ( self->spirvCacheDirectory.empty() ) {
+		return false;
+	}
+
+	auto entry_path = spirv_cache_get_entry_path( self, key );
+
+	std::error_code ec;
+	if ( !std::filesystem::exists( entry_path, ec ) ) {
+		return false;
+	}
+
+	bool success = false;
+	*spirv       = load_file( entry_path, &success );
+
+	// Reject anything which does not look like spir-v code
+	static const uint32_t SPIRV_MAGIC = 0x07230203;
+	uint32_t              magic       = 0;
+
+	if ( success && spirv->size() >= sizeof( uint32_t ) && spirv->size() % sizeof( uint32_t ) == 0 ) {
+		memcpy( &magic, spirv->data(), sizeof( uint32_t ) );
+	}
+
+	if ( magic != SPIRV_MAGIC ) {
+		spirv->clear();
+		return false;
+	}
+
+	return true;
+}
+
+// ---------------------------------------------------------------
+// Store spir-v code for `key` - we write to a temporary file first, and then rename it,
+// so that concurrent readers never see a partially written cache entry.
+static void spirv_cache_store( le_shader_compiler_o const *self, uint64_t key, char const *spirv, size_t spirvNumBytes ) {
+
+	if ( self->spirvCacheDirectory.empty() ) {
+		return;
+	}
+
+	std::error_code ec;
+	std::filesystem::create_directories( self->spirvCacheDirectory, ec );
+
+	auto entry_path = spirv_cache_get_entry_path( self, key );
+	auto tmp_path   = entry_path;
+
+	// Temporary file name is unique per writer (process id, thread id), so that
+	// concurrent writers of the same entry never write into the same file.
+	tmp_path += "." + std::to_string( getpid() ) +
+	            "." + std::to_string( std::hash<std::thread::id>()( std::this_thread::get_id() ) ) +
+	            ".tmp";
+
+	{
+		std::ofstream file( tmp_path, std::ios::out | std::ios::binary | std::ios::trunc );
+		if ( !file.is_open() ) {
+			return;
+		}
+		file.write( spirv, std::streamsize( spirvNumBytes ) );
+		if ( !file.good() ) {
+			file.close();
+			std::filesystem::remove( tmp_path, ec );
+			return;
+		}
+	}
+
+	std::filesystem::rename( tmp_path, entry_path, ec );
+
+	if ( ec ) {
+		std::filesystem::remove( tmp_path, ec );
+	}
+}
+
 // ---------------------------------------------------------------
 
 static shaderc_include_result *le_shaderc_include_result_create( void *      user_data,
@@ -542,6 +712,14 @@ static le_shader_compilation_result_o *le_shader_compiler_compile_source( le_sha
 	auto preprocessorText         = shaderc_result_get_bytes( preprocessorResult );
 	auto preprocessorTextNumBytes = shaderc_result_get_length( preprocessorResult );
 
+	// -- Look up spir-v cache - if we find a matching entry, we don't have to compile.
+	uint64_t spirvCacheKey = spirv_cache_calculate_key( self, shaderKind, preprocessorText, preprocessorTextNumBytes );
+
+	if ( spirv_cache_load( self, spirvCacheKey, &result->cachedSpirv ) ) {
+		shaderc_result_release( preprocessorResult );
+		return result;
+	}
+
 	// -- Compile preprocessed GLSL into SPIRV
 	result->result = shaderc_compile_into_spv( self->compiler,
 	                                           preprocessorText, preprocessorTextNumBytes,
@@ -554,6 +732,10 @@ static le_shader_compilation_result_o *le_shader_compiler_compile_source( le_sha
 	if ( shaderc_result_get_compilation_status( result->result ) != shaderc_compilation_status_success ) {
 		const char *err_msg = shaderc_result_get_error_message( result->result );
 		le_shader_compiler_print_error_context( err_msg, preprocessorText, original_file_path );
+	} else {
+		spirv_cache_store( self, spirvCacheKey,
+		                   shaderc_result_get_bytes( result->result ),
+		                   shaderc_result_get_length( result->result ) );
 	}
 
 	// -- free preprocessor compilation result
@@ -2381,25 +2381,46 @@ static void le_stage_setup_pipelines( le_stage_o *stage ) {
 	// Get set of unique combinations of vertex inputs
 	// and material defines, and associate a shader with each.
 
-	// Create shaders from unique defines
+	// Create shaders from unique defines - we create all shader modules in one batch,
+	// so that they may be compiled concurrently.
 
-	for ( auto &shader : shader_map ) {
+	{
+		std::vector<std::string> shader_defines; // one per shader_map entry
+		shader_defines.reserve( shader_map.size() );
+
+		for ( auto &shader : shader_map ) {
+
+			std::string defines = vertex_input_defines_hash_to_defines_str[ shader.second.signature.hash_vertex_input_defines ];
+			defines             = defines + materials_defines_hash_to_defines_str[ shader.second.signature.hash_materials_defines ];
 
-		std::string defines = vertex_input_defines_hash_to_defines_str[ shader.second.signature.hash_vertex_input_defines ];
-		defines             = defines + materials_defines_hash_to_defines_str[ shader.second.signature.hash_materials_defines ];
+			std::cout << "Creating shader instance using defines: \n\t'-D" << defines << "'" << std::endl
+			          << std::flush;
+
+			shader_defines.emplace_back( std::move( defines ) );
+		}
 
-		std::cout << "Creating shader instance using defines: \n\t'-D" << defines << "'" << std::endl
-		          << std::flush;
+		std::vector<char const *>         paths;
+		std::vector<LeShaderStageEnum>    stages;
+		std::vector<char const *>         macro_definitions;
+		std::vector<le_shader_module_o *> modules( 2 * shader_map.size(), nullptr ); // vert, frag for each shader_map entry
 
-		shader.second.vert = renderer_i.create_shader_module(
-		    stage->renderer,
-		    "./resources/shaders/le_stage/gltf.vert",
-		    { le::ShaderStage::eVertex }, defines.c_str() );
+		for ( auto const &d : shader_defines ) {
+			paths.push_back( "./resources/shaders/le_stage/gltf.vert" );
+			stages.push_back( { le::ShaderStage::eVertex } );
+			macro_definitions.push_back( d.c_str() );
 
-		shader.second.frag = renderer_i.create_shader_module(
-		    stage->renderer,
-		    "./resources/shaders/le_stage/metallic-roughness.frag",
-		    { le::ShaderStage::eFragment }, defines.c_str() );
+			paths.push_back( "./resources/shaders/le_stage/metallic-roughness.frag" );
+			stages.push_back( { le::ShaderStage::eFragment } );
+			macro_definitions.push_back( d.c_str() );
+		}
+
+		renderer_i.create_shader_modules( stage->renderer, uint32_t( modules.size() ), paths.data(), stages.data(), macro_definitions.data(), modules.data() );
+
+		size_t i = 0;
+		for ( auto &shader : shader_map ) {
+			shader.second.vert = modules[ i++ ];
+			shader.second.frag = modules[ i++ ];
+		}
 	}
 
 	std::unordered_map<le_gpso_handle, uint64_t> pipelineCount; // Only used for debug purposes, count number of unique pipelines